@@ -25,7 +25,10 @@
 #include "lcd_port.h"
 #include "lcd_driver.h"
 #include "API_uart.h"
-#include <stdio.h>
+#include "API_telemetry.h"
+#include "API_scheduler.h"
+#include "API_delay.h"
+#include "API_log.h"
 #include <string.h>
 
 /* Private includes ----------------------------------------------------------*/
@@ -40,7 +43,14 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
-
+#define IMU_USE_DATA_READY    1         // 1: lectura por interrupción de dato listo, 0: vaciado de la FIFO
+#define IMU_PERIOD_US         20000     // 50 Hz: publicación de la muestra / vaciado de la FIFO (el MPU6050 muestrea a 1 kHz)
+#define BARO_PROFILE          BMP280_PROFILE_STANDARD
+#define BARO_FORCED_PERIOD_US 500000    // modo forzado: disparo y lectura en ejecuciones alternas -> 1 muestra/s
+#define TELEMETRY_PERIOD_US   50000     // 20 Hz
+#define LCD_PERIOD_US         250000    // 4 Hz
+#define STATS_PERIOD_US       5000000
+#define SEA_LEVEL_HPA         1011.2f
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -55,7 +65,11 @@ I2C_HandleTypeDef hi2c3;
 UART_HandleTypeDef huart2;
 
 /* USER CODE BEGIN PV */
-
+// Últimos valores adquiridos, compartidos entre tareas
+static telemetryImu_t imu_latest;
+static telemetryEnv_t env_latest;
+static bool_t env_updated = false;
+static int8_t baro_task = -1;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -65,7 +79,21 @@ static void MX_GPIO_Init(void);
 //static void MX_I2C1_Init(void);
 //static void MX_I2C3_Init(void);
 /* USER CODE BEGIN PFP */
-
+static void TaskImu(void *context);
+static void ImuPublishLatest(void);
+static void TaskBaro(void *context);
+static void BaroSetProfile(BMP280_Profile profile);
+static bool_t BaroIsForced(void);
+static uint32_t BaroPeriodUs(void);
+static void TaskTelemetry(void *context);
+static void TaskLcd(void *context);
+static void TaskStats(void *context);
+#if BMP280_PORT_BENCHMARK
+static void BaroPortBenchmark(void);
+#endif
+#if BMP280_COMP_BENCHMARK
+static void BaroCompBenchmark(void);
+#endif
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
@@ -104,34 +132,41 @@ int main(void)
   MX_GPIO_Init();
   /* USER CODE BEGIN 2 */
 
+  uartInit();
+  telemetryInit();
   LCD_PortI2C_Init();
   LCD_Begin(20, 4);
-  MPU6050_PortI2C_Init();
+  MPU6050_PortI2C_Init(MPU6050_I2C_BUS);
   MPU6050_Check();
-  uartInit();
+#if IMU_USE_DATA_READY
+  MPU6050_DataReadyEnable(NULL);
+#else
+  MPU6050_FifoEnable();
+#endif
   BMP280_SPI_Init();
   BMP280_SPI_CS_Init();
   BMP280_Init();
+  BaroSetProfile(BARO_PROFILE);
+#if BMP280_PORT_BENCHMARK
+  BaroPortBenchmark();
+#endif
+#if BMP280_COMP_BENCHMARK
+  BaroCompBenchmark();
+#endif
+
+  schedulerInit(delayGetMicros);
+  schedulerAddTask("imu", TaskImu, NULL, IMU_PERIOD_US, 0);
+  baro_task = schedulerAddTask("baro", TaskBaro, NULL, BaroPeriodUs(), 1000);
+  schedulerAddTask("telemetry", TaskTelemetry, NULL, TELEMETRY_PERIOD_US, 2000);
+  schedulerAddTask("lcd", TaskLcd, NULL, LCD_PERIOD_US, 3000);
+  schedulerAddTask("stats", TaskStats, NULL, STATS_PERIOD_US, STATS_PERIOD_US);
   /* USER CODE END 2 */
 
   /* Infinite loop */
   /* USER CODE BEGIN WHILE */
   while (1)
   {
-		float temp_BMP280 = BMP280_ReadTemperature();
-		float pressure = BMP280_ReadPressure();
-		float altitude = BMP280_ReadAltitude(1011.2f);
-
-		char msg[100];
-		snprintf(msg, sizeof(msg), "T=%.2f°C  P=%.2f hPa  ALT=%.2f m\r\n", temp_BMP280, pressure, altitude);
-		uartSendString((uint8_t*)msg);
-
-		int16_t temp = MPU6050_GetTemperatureInt();
-		Vector3i16 gyro = MPU6050_GetGyroscopeInt();
-		Vector3i16 accel = MPU6050_GetAccelerometerInt();
-		LCD_PrintSensorData(temp,gyro.x , accel.x );
-		HAL_Delay(1000);
-
+    schedulerRunOnce();
   }
   /* USER CODE END 3 */
 }
@@ -325,6 +360,171 @@ static void MX_GPIO_Init(void)
 
 /* USER CODE BEGIN 4 */
 
+/*
+ * IMU con dato listo: el EXTI del MPU6050 ya lanzó la lectura de cada muestra; aquí solo se
+ * publica la más reciente.
+ * IMU con FIFO: recoge el lote del vaciado anterior y lanza el siguiente. Si el anterior sigue
+ * en curso no espera: se vuelve a intentar en el próximo período.
+ */
+static void TaskImu(void *context)
+{
+#if IMU_USE_DATA_READY
+	if (MPU6050_GetAcquisitionResult(NULL)) ImuPublishLatest();
+#else
+	bool_t overflow;
+
+	if (MPU6050_FifoGetState() == MPU6050_ACQ_BUSY) return;
+
+	if (MPU6050_FifoGetBatch(NULL, 0, &overflow) > 0) ImuPublishLatest();
+	if (overflow) LOG("MPU6050 FIFO overflow (total=%u)", MPU6050_FifoGetOverflowCount());
+
+	MPU6050_FifoStartDrain();
+#endif
+}
+
+static void ImuPublishLatest(void)
+{
+	Vector3i32 gyro = MPU6050_GetGyroscopeInt();
+	Vector3i32 accel = MPU6050_GetAccelerometerInt();
+
+	imu_latest.temp_x100 = MPU6050_GetTemperatureInt();
+	imu_latest.gyro_x100[0] = gyro.x;
+	imu_latest.gyro_x100[1] = gyro.y;
+	imu_latest.gyro_x100[2] = gyro.z;
+	imu_latest.accel_x100[0] = accel.x;
+	imu_latest.accel_x100[1] = accel.y;
+	imu_latest.accel_x100[2] = accel.z;
+}
+
+/*
+ * Barómetro: mismo esquema que la IMU, al ritmo de salida del BMP280.
+ * En modo forzado el sensor duerme entre muestras: una ejecución dispara la conversión y la
+ * siguiente, ya terminada, lanza la lectura por DMA, cuyo resultado se publica en la próxima.
+ */
+static void TaskBaro(void *context)
+{
+	BMP280_Measurement bmp280;
+
+	if (BMP280_GetAcquisitionState() == BMP280_ACQ_BUSY) return;
+
+	if (BMP280_GetAcquisitionResult(&bmp280))
+	{
+		float altitude = BMP280_CalcAltitude(bmp280.pressure, SEA_LEVEL_HPA);
+
+		env_latest.temp_x100 = (int16_t)(bmp280.temperature * 100.0f);
+		env_latest.pressure_pa = (uint32_t)(bmp280.pressure * 100.0f);
+		env_latest.altitude_cm = (int32_t)(altitude * 100.0f);
+		env_updated = true;
+	}
+
+	if (BaroIsForced())
+	{
+		if (BMP280_IsConversionDone()) BMP280_StartAcquisition();
+		else BMP280_TriggerConversion();
+		return;
+	}
+	BMP280_StartAcquisition();
+}
+
+/*
+ * Cambia el perfil del BMP280 y el período de la tarea del barómetro junto con él, para que la
+ * tarea siga consultando una vez por conversión nueva. Usar en lugar de BMP280_SetProfile().
+ */
+static void BaroSetProfile(BMP280_Profile profile)
+{
+	if (!BMP280_SetProfile(profile)) return;
+	if (baro_task >= 0) schedulerSetPeriod(baro_task, BaroPeriodUs());
+}
+
+static bool_t BaroIsForced(void)
+{
+	BMP280_Settings settings;
+
+	BMP280_GetSettings(&settings);
+	return settings.mode == BMP280_OPMODE_FORCED;
+}
+
+/*
+ * Período de la tarea del barómetro. En modo normal, uno por conversión nueva; en modo forzado
+ * BMP280_GetSamplePeriodUs() es solo t_meas (el mínimo entre disparos), así que se usa un
+ * período fijo para no despertar al sensor cada pocos ms.
+ */
+static uint32_t BaroPeriodUs(void)
+{
+	uint32_t period_us = BMP280_GetSamplePeriodUs();
+
+	if (BaroIsForced() && period_us < BARO_FORCED_PERIOD_US) period_us = BARO_FORCED_PERIOD_US;
+	return period_us;
+}
+
+static void TaskTelemetry(void *context)
+{
+	telemetrySendImu(&imu_latest);
+
+	if (env_updated)
+	{
+		telemetrySendEnv(&env_latest);
+		env_updated = false;
+	}
+}
+
+static void TaskLcd(void *context)
+{
+	LCD_SensorSnapshot snapshot = { imu_latest.temp_x100, imu_latest.gyro_x100[0], imu_latest.accel_x100[0] };
+
+	LCD_SubmitSensorData(&snapshot);
+	LCD_RenderProcess();
+}
+
+/*
+ * Reporta las estadísticas de cada tarea de la última ventana y las reinicia.
+ */
+static void TaskStats(void *context)
+{
+	schedulerStats_t stats;
+
+	for (int8_t id = 0; id < schedulerGetTaskCount(); id++)
+	{
+		if (!schedulerGetStats(id, &stats)) continue;
+		LOG("TASK %u runs=%u overruns=%u jitter_max=%u us exec_max=%u us",
+		    id, stats.runs, stats.overruns, stats.max_jitter_us, stats.max_exec_us);
+	}
+	schedulerResetStats();
+#if IMU_USE_DATA_READY
+	LOG("MPU6050 data-ready missed=%u", MPU6050_DataReadyGetMissedCount());
+#endif
+}
+
+#if BMP280_PORT_BENCHMARK
+/*
+ * Compara en ciclos de CPU los back-ends HAL y LL de los accesos bloqueantes al BMP280.
+ */
+static void BaroPortBenchmark(void)
+{
+	static SPI_BusDevice spi;
+	BMP280_PortBenchmark bench;
+
+	BMP280_PortSPI_DeviceInit(&spi, BMP280_CS_GPIO_PORT, BMP280_CS_PIN);
+	BMP280_PortSPI_Benchmark(&spi, &bench);
+	LOG("BMP280 SPI cycles: read1 HAL=%u LL=%u, read24 HAL=%u LL=%u",
+	    bench.hal_read1, bench.ll_read1, bench.hal_read24, bench.ll_read24);
+}
+#endif
+
+#if BMP280_COMP_BENCHMARK
+/*
+ * Mide en ciclos de CPU cada back-end de compensación del BMP280.
+ */
+static void BaroCompBenchmark(void)
+{
+	BMP280_CompBenchmark bench;
+
+	BMP280_CompMeasureCycles(&bench);
+	LOG("BMP280 comp cycles: temp int32=%u float=%u, press int64=%u int32=%u float=%u",
+	    bench.temp_int32, bench.temp_float, bench.press_int64, bench.press_int32, bench.press_float);
+}
+#endif
+
 /* USER CODE END 4 */
 
 /**
@@ -335,6 +535,7 @@ void Error_Handler(void)
 {
   /* USER CODE BEGIN Error_Handler_Debug */
   /* User can add his own implementation to report the HAL error return state */
+  uartFlush();
   __disable_irq();
   while (1)
   {
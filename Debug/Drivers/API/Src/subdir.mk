@@ -5,31 +5,55 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../Drivers/API/Src/API_altitude.c \
+../Drivers/API/Src/API_delay.c \
+../Drivers/API/Src/API_log.c \
+../Drivers/API/Src/API_scheduler.c \
+../Drivers/API/Src/API_telemetry.c \
 ../Drivers/API/Src/API_uart.c \
+../Drivers/API/Src/bmp280_comp.c \
 ../Drivers/API/Src/bmp280_driver.c \
 ../Drivers/API/Src/bmp280_port.c \
+../Drivers/API/Src/i2c_bus.c \
 ../Drivers/API/Src/lcd_driver.c \
 ../Drivers/API/Src/lcd_port.c \
 ../Drivers/API/Src/mpu6050_driver.c \
-../Drivers/API/Src/mpu6050_port.c 
+../Drivers/API/Src/mpu6050_port.c \
+../Drivers/API/Src/spi_bus.c 
 
 OBJS += \
+./Drivers/API/Src/API_altitude.o \
+./Drivers/API/Src/API_delay.o \
+./Drivers/API/Src/API_log.o \
+./Drivers/API/Src/API_scheduler.o \
+./Drivers/API/Src/API_telemetry.o \
 ./Drivers/API/Src/API_uart.o \
+./Drivers/API/Src/bmp280_comp.o \
 ./Drivers/API/Src/bmp280_driver.o \
 ./Drivers/API/Src/bmp280_port.o \
+./Drivers/API/Src/i2c_bus.o \
 ./Drivers/API/Src/lcd_driver.o \
 ./Drivers/API/Src/lcd_port.o \
 ./Drivers/API/Src/mpu6050_driver.o \
-./Drivers/API/Src/mpu6050_port.o 
+./Drivers/API/Src/mpu6050_port.o \
+./Drivers/API/Src/spi_bus.o 
 
 C_DEPS += \
+./Drivers/API/Src/API_altitude.d \
+./Drivers/API/Src/API_delay.d \
+./Drivers/API/Src/API_log.d \
+./Drivers/API/Src/API_scheduler.d \
+./Drivers/API/Src/API_telemetry.d \
 ./Drivers/API/Src/API_uart.d \
+./Drivers/API/Src/bmp280_comp.d \
 ./Drivers/API/Src/bmp280_driver.d \
 ./Drivers/API/Src/bmp280_port.d \
+./Drivers/API/Src/i2c_bus.d \
 ./Drivers/API/Src/lcd_driver.d \
 ./Drivers/API/Src/lcd_port.d \
 ./Drivers/API/Src/mpu6050_driver.d \
-./Drivers/API/Src/mpu6050_port.d 
+./Drivers/API/Src/mpu6050_port.d \
+./Drivers/API/Src/spi_bus.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -39,7 +63,7 @@ Drivers/API/Src/%.o Drivers/API/Src/%.su Drivers/API/Src/%.cyclo: ../Drivers/API
 clean: clean-Drivers-2f-API-2f-Src
 
 clean-Drivers-2f-API-2f-Src:
-	-$(RM) ./Drivers/API/Src/API_uart.cyclo ./Drivers/API/Src/API_uart.d ./Drivers/API/Src/API_uart.o ./Drivers/API/Src/API_uart.su ./Drivers/API/Src/bmp280_driver.cyclo ./Drivers/API/Src/bmp280_driver.d ./Drivers/API/Src/bmp280_driver.o ./Drivers/API/Src/bmp280_driver.su ./Drivers/API/Src/bmp280_port.cyclo ./Drivers/API/Src/bmp280_port.d ./Drivers/API/Src/bmp280_port.o ./Drivers/API/Src/bmp280_port.su ./Drivers/API/Src/lcd_driver.cyclo ./Drivers/API/Src/lcd_driver.d ./Drivers/API/Src/lcd_driver.o ./Drivers/API/Src/lcd_driver.su ./Drivers/API/Src/lcd_port.cyclo ./Drivers/API/Src/lcd_port.d ./Drivers/API/Src/lcd_port.o ./Drivers/API/Src/lcd_port.su ./Drivers/API/Src/mpu6050_driver.cyclo ./Drivers/API/Src/mpu6050_driver.d ./Drivers/API/Src/mpu6050_driver.o ./Drivers/API/Src/mpu6050_driver.su ./Drivers/API/Src/mpu6050_port.cyclo ./Drivers/API/Src/mpu6050_port.d ./Drivers/API/Src/mpu6050_port.o ./Drivers/API/Src/mpu6050_port.su
+	-$(RM) ./Drivers/API/Src/API_altitude.cyclo ./Drivers/API/Src/API_altitude.d ./Drivers/API/Src/API_altitude.o ./Drivers/API/Src/API_altitude.su ./Drivers/API/Src/API_delay.cyclo ./Drivers/API/Src/API_delay.d ./Drivers/API/Src/API_delay.o ./Drivers/API/Src/API_delay.su ./Drivers/API/Src/API_log.cyclo ./Drivers/API/Src/API_log.d ./Drivers/API/Src/API_log.o ./Drivers/API/Src/API_log.su ./Drivers/API/Src/API_scheduler.cyclo ./Drivers/API/Src/API_scheduler.d ./Drivers/API/Src/API_scheduler.o ./Drivers/API/Src/API_scheduler.su ./Drivers/API/Src/API_telemetry.cyclo ./Drivers/API/Src/API_telemetry.d ./Drivers/API/Src/API_telemetry.o ./Drivers/API/Src/API_telemetry.su ./Drivers/API/Src/API_uart.cyclo ./Drivers/API/Src/API_uart.d ./Drivers/API/Src/API_uart.o ./Drivers/API/Src/API_uart.su ./Drivers/API/Src/bmp280_comp.cyclo ./Drivers/API/Src/bmp280_comp.d ./Drivers/API/Src/bmp280_comp.o ./Drivers/API/Src/bmp280_comp.su ./Drivers/API/Src/bmp280_driver.cyclo ./Drivers/API/Src/bmp280_driver.d ./Drivers/API/Src/bmp280_driver.o ./Drivers/API/Src/bmp280_driver.su ./Drivers/API/Src/bmp280_port.cyclo ./Drivers/API/Src/bmp280_port.d ./Drivers/API/Src/bmp280_port.o ./Drivers/API/Src/bmp280_port.su ./Drivers/API/Src/i2c_bus.cyclo ./Drivers/API/Src/i2c_bus.d ./Drivers/API/Src/i2c_bus.o ./Drivers/API/Src/i2c_bus.su ./Drivers/API/Src/lcd_driver.cyclo ./Drivers/API/Src/lcd_driver.d ./Drivers/API/Src/lcd_driver.o ./Drivers/API/Src/lcd_driver.su ./Drivers/API/Src/lcd_port.cyclo ./Drivers/API/Src/lcd_port.d ./Drivers/API/Src/lcd_port.o ./Drivers/API/Src/lcd_port.su ./Drivers/API/Src/mpu6050_driver.cyclo ./Drivers/API/Src/mpu6050_driver.d ./Drivers/API/Src/mpu6050_driver.o ./Drivers/API/Src/mpu6050_driver.su ./Drivers/API/Src/mpu6050_port.cyclo ./Drivers/API/Src/mpu6050_port.d ./Drivers/API/Src/mpu6050_port.o ./Drivers/API/Src/mpu6050_port.su ./Drivers/API/Src/spi_bus.cyclo ./Drivers/API/Src/spi_bus.d ./Drivers/API/Src/spi_bus.o ./Drivers/API/Src/spi_bus.su
 
 .PHONY: clean-Drivers-2f-API-2f-Src
 
@@ -0,0 +1,27 @@
+/*
+ * API_altitude.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ */
+
+#ifndef API_INC_API_ALTITUDE_H_
+#define API_INC_API_ALTITUDE_H_
+
+#include <stdint.h>
+
+/*
+ * Barometric altitude h = 44330 * (1 - (p / p0)^0.1903) without powf:
+ * linear interpolation over a 257-entry table of p / p0 in [0.25, 1.25]
+ * (about -1900 m .. +10300 m). Worst-case error vs powf: 0.16 m at p/p0 = 0.25,
+ * under 0.03 m for p/p0 >= 0.7 (below ~2900 m). Outside the range the edge
+ * segments are extrapolated.
+ */
+#define ALTITUDE_RATIO_MIN      0.25f
+#define ALTITUDE_RATIO_MAX      1.25f
+#define ALTITUDE_TABLE_STEPS    256
+
+float altitudeFromPressure(float pressure_hpa, float sea_level_hpa);
+void altitudeFromPressureBatch(const float *pressure_hpa, float *altitude_m, uint16_t count, float sea_level_hpa);
+
+#endif /* API_INC_API_ALTITUDE_H_ */
@@ -0,0 +1,23 @@
+/*
+ * API_delay.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ */
+
+#ifndef API_INC_API_DELAY_H_
+#define API_INC_API_DELAY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+
+typedef bool bool_t;
+
+
+bool_t delayUsInit(void);
+void delayUs(uint32_t us);
+uint32_t delayGetCycles(void);
+uint32_t delayGetMicros(void);
+
+#endif /* API_INC_API_DELAY_H_ */
@@ -0,0 +1,46 @@
+/*
+ * API_log.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ */
+
+#ifndef API_INC_API_LOG_H_
+#define API_INC_API_LOG_H_
+
+#include <stdint.h>
+#include <string.h>
+#include "API_telemetry.h"
+
+/*
+ * Tokenized logging: the format string is placed in the .log_fmt section, which the linker
+ * script keeps out of flash (INFO, address 0). The string's address is its offset in the
+ * dictionary and is sent as the message ID; the host tool expands the format.
+ *
+ * Arguments are sent as raw 32-bit words: integers and chars as-is, floats through LOG_FLOAT().
+ * %s is not supported.
+ *
+ * Build: arm-none-eabi-objcopy --dump-section .log_fmt=proyecto.logdict proyecto.elf
+ */
+#define LOG_MAX_ARGS   ((TELEMETRY_MAX_PAYLOAD - sizeof(uint16_t)) / sizeof(uint32_t))
+
+#define LOG(fmt, ...)                                                                      \
+	do {                                                                                   \
+		static const char log_fmt[] __attribute__((section(".log_fmt"), used)) = fmt;      \
+		const uint32_t log_args[] = { 0, ##__VA_ARGS__ };                                  \
+		logEmit((uint16_t)(uintptr_t)log_fmt, &log_args[1],                               \
+		        (sizeof(log_args) / sizeof(log_args[0])) - 1);                             \
+	} while (0)
+
+#define LOG_FLOAT(x)   logFloatBits(x)
+
+static inline uint32_t logFloatBits(float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+void logEmit(uint16_t id, const uint32_t *args, uint8_t count);
+
+#endif /* API_INC_API_LOG_H_ */
@@ -0,0 +1,42 @@
+/*
+ * API_scheduler.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ */
+
+#ifndef API_INC_API_SCHEDULER_H_
+#define API_INC_API_SCHEDULER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef bool bool_t;
+
+#define SCHEDULER_MAX_TASKS   8
+
+// Time source in microseconds (wraps); on target delayGetMicros, on host a simulated clock
+typedef uint32_t (*schedulerClock_t)(void);
+typedef void (*schedulerTaskFn_t)(void *context);
+
+typedef struct
+{
+	uint32_t runs;
+	uint32_t overruns;          // releases missed or finished after the next release
+	uint32_t max_jitter_us;     // start time - release time
+	uint32_t max_exec_us;
+	uint32_t last_jitter_us;
+	uint32_t last_exec_us;
+} schedulerStats_t;
+
+void schedulerInit(schedulerClock_t clock);
+int8_t schedulerAddTask(const char *name, schedulerTaskFn_t fn, void *context, uint32_t period_us, uint32_t offset_us);
+bool_t schedulerSetPeriod(int8_t id, uint32_t period_us);
+bool_t schedulerRunOnce(void);
+void schedulerRun(void);
+bool_t schedulerGetStats(int8_t id, schedulerStats_t *stats);
+const char *schedulerGetName(int8_t id);
+uint8_t schedulerGetTaskCount(void);
+void schedulerResetStats(void);
+
+#endif /* API_INC_API_SCHEDULER_H_ */
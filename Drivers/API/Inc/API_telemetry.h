@@ -0,0 +1,57 @@
+/*
+ * API_telemetry.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ */
+
+#ifndef API_INC_API_TELEMETRY_H_
+#define API_INC_API_TELEMETRY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "stm32f4xx_hal.h"
+
+typedef bool bool_t;
+
+/*
+ * Frame (before COBS, little endian):
+ *   type u8 | seq u8 | timestamp_ms u32 | payload | crc32 u32
+ * crc32 = STM32 CRC unit (poly 0x04C11DB7, init 0xFFFFFFFF) over type..payload,
+ * zero-padded to a multiple of 4 and fed as little-endian words.
+ * On the wire: COBS(frame) followed by a 0x00 delimiter.
+ */
+#define TELEMETRY_HEADER_SIZE   6
+#define TELEMETRY_CRC_SIZE      4
+#define TELEMETRY_MAX_PAYLOAD   32
+#define TELEMETRY_MAX_FRAME     (TELEMETRY_HEADER_SIZE + TELEMETRY_MAX_PAYLOAD + TELEMETRY_CRC_SIZE)
+// COBS adds one byte every 254 plus the delimiter
+#define TELEMETRY_MAX_ENCODED   (TELEMETRY_MAX_FRAME + TELEMETRY_MAX_FRAME / 254 + 2)
+
+typedef enum
+{
+	TELEMETRY_TYPE_ENV = 0x01,     // BMP280
+	TELEMETRY_TYPE_IMU = 0x02,     // MPU6050
+	TELEMETRY_TYPE_LOG = 0x03      // tokenized log (API_log.h)
+} telemetryType_t;
+
+typedef struct
+{
+	int16_t  temp_x100;            // °C x100
+	uint32_t pressure_pa;          // Pa (hPa x100)
+	int32_t  altitude_cm;
+} telemetryEnv_t;
+
+typedef struct
+{
+	int16_t temp_x100;             // °C x100
+	int32_t gyro_x100[3];          // °/s x100 (±200000 at ±2000 °/s)
+	int16_t accel_x100[3];         // g x100
+} telemetryImu_t;
+
+bool_t telemetryInit(void);
+bool_t telemetrySendFrame(telemetryType_t type, const uint8_t *payload, uint8_t size);
+bool_t telemetrySendEnv(const telemetryEnv_t *env);
+bool_t telemetrySendImu(const telemetryImu_t *imu);
+
+#endif /* API_INC_API_TELEMETRY_H_ */
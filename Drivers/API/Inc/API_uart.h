@@ -14,10 +14,38 @@
 
 typedef bool bool_t;
 
+#define UART_TX_BUFFER_SIZE 1024
+#define UART_RX_DMA_SIZE    256     // circular DMA buffer
+#define UART_RX_FRAME_SIZE  128     // max frame length, longer frames are truncated
+#define UART_RX_FRAME_COUNT 4       // frames queued for the application
+
+typedef struct
+{
+	uint32_t dropped_messages;   // messages discarded because the ring was full
+	uint32_t dropped_bytes;
+	uint16_t high_water;         // max bytes pending in the ring
+} uartTxStats_t;
+
+typedef struct
+{
+	uint32_t frames;             // frames delivered to the queue
+	uint32_t dropped_frames;     // frames discarded because the queue was full
+	uint32_t truncated_frames;   // frames longer than UART_RX_FRAME_SIZE
+	uint32_t errors;             // line errors (reception is restarted)
+} uartRxStats_t;
+
 
 bool_t uartInit();
 void uartSendString(uint8_t * pstring);
 void uartSendStringSize(uint8_t * pstring, uint16_t size);
 void uartReceiveStringSize(uint8_t * pstring, uint16_t size);
+void uartFlush(void);
+void uartGetTxStats(uartTxStats_t *stats);
+uint16_t uartReceiveFrame(uint8_t * pframe, uint16_t size);
+void uartGetRxStats(uartRxStats_t *stats);
+
+void uartIRQHandler(void);
+void uartDmaTxIRQHandler(void);
+void uartDmaRxIRQHandler(void);
 
 #endif /* API_INC_API_UART_H_ */
@@ -0,0 +1,73 @@
+/*
+ * bmp280_comp.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ */
+
+#ifndef API_INC_BMP280_COMP_H_
+#define API_INC_BMP280_COMP_H_
+
+#include <stdint.h>
+
+// Compensation back-ends
+#define BMP280_COMP_INT64  0   // Bosch 64-bit reference (links __aeabi_ldivmod)
+#define BMP280_COMP_INT32  1   // Bosch 32-bit fixed point, 1 Pa resolution
+#define BMP280_COMP_FLOAT  2   // single precision, FPU
+
+// Back-end used by bmp280_driver
+#ifndef BMP280_COMP_BACKEND
+#define BMP280_COMP_BACKEND  BMP280_COMP_FLOAT
+#endif
+
+// 1: build BMP280_CompMeasureCycles() (DWT cycles per back-end, requires delayUsInit())
+#ifndef BMP280_COMP_BENCHMARK
+#define BMP280_COMP_BENCHMARK  0
+#endif
+
+// Calibration block 0x88..0x9F
+#define BMP280_CALIB_LENGTH  24
+
+typedef struct
+{
+	// Raw trimming parameters (64-bit reference)
+	uint16_t dig_T1, dig_P1;
+	int16_t  dig_T2, dig_T3;
+	int16_t  dig_P2, dig_P3, dig_P4, dig_P5, dig_P6, dig_P7, dig_P8, dig_P9;
+
+	// 32-bit fixed point, constant terms already shifted
+	int32_t  t1_x2;      // dig_T1 << 1
+	int32_t  p4_s16;     // dig_P4 << 16
+	int32_t  p5_x2;      // dig_P5 << 1
+
+	// Single precision, divisions folded into the coefficients
+	float    ft1_1024, ft1_8192, ft2, ft3;
+	float    fp1, fp1_32768, fp2, fp3, fp4, fp5, fp6, fp7_16, fp8, fp9;
+} BMP280_CompCoeffs;
+
+// Minimum DWT cycles per call (datasheet calibration and sample)
+typedef struct
+{
+	uint32_t temp_int32;
+	uint32_t temp_float;
+	uint32_t press_int64;
+	uint32_t press_int32;
+	uint32_t press_float;
+} BMP280_CompBenchmark;
+
+void BMP280_CompInit(BMP280_CompCoeffs *c, const uint8_t *calib);
+
+// Temperature: 0.01 °C (int) or °C (float); t_fine feeds the pressure of the same conversion
+int32_t  BMP280_CompTemperatureInt32(const BMP280_CompCoeffs *c, int32_t adc_T, int32_t *t_fine);
+float    BMP280_CompTemperatureFloat(const BMP280_CompCoeffs *c, int32_t adc_T, float *t_fine);
+
+// Pressure: Q24.8 Pa (int64), Pa (int32 and float)
+uint32_t BMP280_CompPressureInt64(const BMP280_CompCoeffs *c, int32_t adc_P, int32_t t_fine);
+uint32_t BMP280_CompPressureInt32(const BMP280_CompCoeffs *c, int32_t adc_P, int32_t t_fine);
+float    BMP280_CompPressureFloat(const BMP280_CompCoeffs *c, int32_t adc_P, float t_fine);
+
+#if BMP280_COMP_BENCHMARK
+void BMP280_CompMeasureCycles(BMP280_CompBenchmark *result);
+#endif
+
+#endif /* API_INC_BMP280_COMP_H_ */
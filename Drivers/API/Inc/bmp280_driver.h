@@ -8,18 +8,183 @@
 #ifndef API_INC_BMP280_DRIVER_H_
 #define API_INC_BMP280_DRIVER_H_
 
+#include "stdbool.h"
 #include "stdint.h"
+#include "bmp280_port.h"
+#include "bmp280_comp.h"
+typedef bool bool_t;
 
 #define BMP280_CHIP_ID         0x58
 #define BMP280_RESET_VALUE     0xB6
 #define BMP280_REG_ID          0xD0
 #define BMP280_REG_RESET       0xE0
+#define BMP280_REG_STATUS      0xF3
 #define BMP280_REG_CTRL_MEAS   0xF4
 #define BMP280_REG_CONFIG      0xF5
 #define BMP280_REG_PRESS_MSB   0xF7
 #define BMP280_REG_TEMP_MSB    0xFA
 #define BMP280_REG_CALIB_START 0x88
 
+// Burst Measurements (PRESS_MSB .. TEMP_XLSB)
+#define BMP280_BURST_LENGTH    6
+
+// Sensors per BMP280_SeqStart() chain
+#define BMP280_SEQ_MAX_DEVICES 4
+
+// ctrl_meas: osrs_t[7:5] | osrs_p[4:2] | mode[1:0]
+#define BMP280_OSRS_T_POS      5
+#define BMP280_OSRS_P_POS      2
+#define BMP280_MODE_SLEEP      0x00
+#define BMP280_MODE_FORCED     0x01
+#define BMP280_MODE_NORMAL     0x03
+
+// status: measuring[3] is set while a conversion is running
+#define BMP280_STATUS_MEASURING 0x08
+
+// config: t_sb[7:5] | filter[4:2] | spi3w_en[0]
+#define BMP280_T_SB_POS        5
+#define BMP280_FILTER_POS      2
+
+// Maximum measurement time (datasheet 3.8.1), in us:
+// 1250 + 2300 * osrs_t + (2300 * osrs_p + 575 if pressure enabled)
+#define BMP280_TMEAS_BASE_US   1250
+#define BMP280_TMEAS_STEP_US   2300
+#define BMP280_TMEAS_PRESS_US  575
+// Typical measurement time: 1000 + 2000 * osrs_t + (2000 * osrs_p + 500 if pressure enabled)
+#define BMP280_TMEAS_TYP_BASE_US   1000
+#define BMP280_TMEAS_TYP_STEP_US   2000
+#define BMP280_TMEAS_TYP_PRESS_US  500
+
+// Oversampling (osrs_t / osrs_p field values)
+typedef enum
+{
+    BMP280_OSRS_SKIP = 0,
+    BMP280_OSRS_X1,
+    BMP280_OSRS_X2,
+    BMP280_OSRS_X4,
+    BMP280_OSRS_X8,
+    BMP280_OSRS_X16
+} BMP280_Oversampling;
+
+// IIR filter coefficient
+typedef enum
+{
+    BMP280_FILTER_OFF = 0,
+    BMP280_FILTER_2,
+    BMP280_FILTER_4,
+    BMP280_FILTER_8,
+    BMP280_FILTER_16
+} BMP280_Filter;
+
+// Inactive time between conversions in normal mode
+typedef enum
+{
+    BMP280_STANDBY_0_5MS = 0,
+    BMP280_STANDBY_62_5MS,
+    BMP280_STANDBY_125MS,
+    BMP280_STANDBY_250MS,
+    BMP280_STANDBY_500MS,
+    BMP280_STANDBY_1000MS,
+    BMP280_STANDBY_2000MS,
+    BMP280_STANDBY_4000MS
+} BMP280_Standby;
+
+// Normal: periodic conversions every t_meas + t_standby.
+// Forced: one conversion per BMP280_TriggerConversion(), sleep in between.
+typedef enum
+{
+    BMP280_OPMODE_NORMAL = 0,
+    BMP280_OPMODE_FORCED
+} BMP280_OpMode;
+
+typedef struct
+{
+    BMP280_Oversampling osrs_t;
+    BMP280_Oversampling osrs_p;
+    BMP280_Filter       filter;
+    BMP280_Standby      standby;   // normal mode only
+    BMP280_OpMode       mode;
+} BMP280_Settings;
+
+// Use cases from the datasheet (table 15)
+typedef enum
+{
+    BMP280_PROFILE_ULTRA_LOW_POWER = 0,  // p x1,  t x1, filter off, 4 s     -> ~0.25 Hz
+    BMP280_PROFILE_STANDARD,             // p x4,  t x1, filter 4,   125 ms  -> ~7.3 Hz
+    BMP280_PROFILE_HIGH_RESOLUTION,      // p x16, t x2, filter 4,   62.5 ms -> ~9.5 Hz
+    BMP280_PROFILE_INDOOR_NAVIGATION,    // p x16, t x2, filter 16,  0.5 ms  -> ~23 Hz
+    BMP280_PROFILE_HIGH_RATE,            // p x2,  t x1, filter off, 0.5 ms  -> ~108 Hz
+    BMP280_PROFILE_WEATHER_MONITORING,   // p x1,  t x1, filter off, forced  -> on demand
+    BMP280_PROFILE_COUNT
+} BMP280_Profile;
+
+typedef struct
+{
+    float temperature;   // °C
+    float pressure;      // hPa
+} BMP280_Measurement;
+
+// Asynchronous (DMA) acquisition state
+
+typedef enum
+{
+    BMP280_ACQ_IDLE = 0,
+    BMP280_ACQ_BUSY,
+    BMP280_ACQ_READY,
+    BMP280_ACQ_ERROR
+} BMP280_AcqState;
+
+// t_fine of the active compensation back-end
+#if BMP280_COMP_BACKEND == BMP280_COMP_FLOAT
+typedef float   BMP280_TFine;
+#else
+typedef int32_t BMP280_TFine;
+#endif
+
+// One sensor on SPI2: bus device (CS, clock, mode), calibration, configuration and acquisition state
+typedef struct
+{
+    SPI_BusDevice            spi;
+    BMP280_CompCoeffs        comp;
+    BMP280_TFine             t_fine;
+
+    BMP280_Settings          settings;
+    uint32_t                 meas_time_us;
+    uint32_t                 meas_time_typ_us;
+    uint8_t                  ctrl_meas_osrs;
+
+    bool_t                   forced_pending;
+    uint32_t                 forced_start_us;
+
+    // [reg | 0x80] + BMP280_BURST_LENGTH dummy bytes
+    uint8_t                  acq_tx[BMP280_BURST_LENGTH + 1];
+    uint8_t                  acq_rx[BMP280_BURST_LENGTH + 1];
+    volatile BMP280_AcqState acq_state;
+} bmp280_dev_t;
+
+// Handle-based API (several sensors sharing SPI2)
+void BMP280_DevInit(bmp280_dev_t *dev, GPIO_TypeDef *cs_port, uint16_t cs_pin);
+uint8_t BMP280_DevRead8(bmp280_dev_t *dev, uint8_t reg);
+void BMP280_DevWrite8(bmp280_dev_t *dev, uint8_t reg, uint8_t value);
+bool_t BMP280_DevSetProfile(bmp280_dev_t *dev, BMP280_Profile profile);
+bool_t BMP280_DevConfigure(bmp280_dev_t *dev, const BMP280_Settings *settings);
+void BMP280_DevGetSettings(const bmp280_dev_t *dev, BMP280_Settings *settings);
+uint32_t BMP280_DevGetMeasurementTimeUs(const bmp280_dev_t *dev);
+uint32_t BMP280_DevGetSamplePeriodUs(const bmp280_dev_t *dev);
+bool_t BMP280_DevTriggerConversion(bmp280_dev_t *dev);
+bool_t BMP280_DevIsConversionDone(bmp280_dev_t *dev);
+bool_t BMP280_DevIsMeasuring(bmp280_dev_t *dev);
+void BMP280_DevReadForced(bmp280_dev_t *dev, BMP280_Measurement *data);
+void BMP280_DevReadAll(bmp280_dev_t *dev, BMP280_Measurement *data);
+bool_t BMP280_DevStartAcquisition(bmp280_dev_t *dev);
+BMP280_AcqState BMP280_DevGetAcquisitionState(const bmp280_dev_t *dev);
+bool_t BMP280_DevGetAcquisitionResult(bmp280_dev_t *dev, BMP280_Measurement *data);
+
+// Bus sequencer: one burst per sensor, chained from the DMA completion interrupt
+bool_t BMP280_SeqStart(bmp280_dev_t *const *devs, uint8_t count);
+BMP280_AcqState BMP280_SeqGetState(void);
+
+// Single-sensor API (default sensor, CS on BMP280_CS_PIN)
 uint8_t BMP280_Read8(uint8_t reg);
 void BMP280_Write8(uint8_t reg, uint8_t value);
 void BMP280_Init(void);
@@ -27,6 +192,26 @@ void BMP280_Restart(void);
 float BMP280_ReadTemperature(void);
 float BMP280_ReadPressure(void);
 float BMP280_ReadAltitude(float sea_level_hPa);
+void BMP280_ReadAll(BMP280_Measurement *data);
+float BMP280_CalcAltitude(float pressure_hPa, float sea_level_hPa);
+
+// Power/performance configuration
+bool_t BMP280_SetProfile(BMP280_Profile profile);
+bool_t BMP280_Configure(const BMP280_Settings *settings);
+void BMP280_GetSettings(BMP280_Settings *settings);
+uint32_t BMP280_GetMeasurementTimeUs(void);
+uint32_t BMP280_GetSamplePeriodUs(void);
+
+// Forced mode (on-demand) acquisition
+bool_t BMP280_TriggerConversion(void);
+bool_t BMP280_IsConversionDone(void);
+bool_t BMP280_IsMeasuring(void);
+void BMP280_ReadForced(BMP280_Measurement *data);
+
+// Asynchronous (DMA) acquisition
+bool_t BMP280_StartAcquisition(void);
+BMP280_AcqState BMP280_GetAcquisitionState(void);
+bool_t BMP280_GetAcquisitionResult(BMP280_Measurement *data);
 
 
 #endif /* API_INC_BMP280_DRIVER_H_ */
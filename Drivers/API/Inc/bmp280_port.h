@@ -10,14 +10,53 @@
 
 #include "stm32f4xx_hal.h"
 #include "stdint.h"
+#include "spi_bus.h"
 
 extern void Error_Handler(void);
 
+// Blocking register access back-ends (the DMA path always uses the HAL)
+#define BMP280_PORT_HAL        0   // HAL_SPI_Transmit/Receive + HAL_GPIO_WritePin
+#define BMP280_PORT_LL         1   // polled SPI2 DR/SR + GPIO BSRR
+
+#ifndef BMP280_PORT_BACKEND
+#define BMP280_PORT_BACKEND    BMP280_PORT_LL
+#endif
+
+// 1: build BMP280_PortSPI_Benchmark() (HAL vs LL cycle counts)
+#ifndef BMP280_PORT_BENCHMARK
+#define BMP280_PORT_BENCHMARK  0
+#endif
+
+// Default sensor chip select (single-sensor API)
+#define BMP280_CS_GPIO_PORT    GPIOA
+#define BMP280_CS_PIN          GPIO_PIN_4
+
+// SPI limits of the sensor (datasheet: 10 MHz, modes 0 and 3)
+#define BMP280_SPI_MAX_CLOCK   10000000
+#define BMP280_SPI_MODE        SPI_BUS_MODE_0
+
+typedef void (*BMP280_PortSPI_Callback)(HAL_StatusTypeDef status, void *context);
+
+// Minimum DWT cycles per transaction, CS edges included
+typedef struct
+{
+    uint32_t hal_read1;    // register address + 1 byte
+    uint32_t ll_read1;
+    uint32_t hal_read24;   // register address + 24 bytes (calibration block)
+    uint32_t ll_read24;
+} BMP280_PortBenchmark;
+
 void BMP280_SPI_Init(void);
 void BMP280_SPI_CS_Init(void);
-void BMP280_PortSPI_WriteRegister(uint8_t * valor, uint8_t size);
-void BMP280_PortSPI_ReadRegister(uint8_t *valor, uint8_t size);
+void BMP280_PortSPI_DeviceInit(SPI_BusDevice *spi, GPIO_TypeDef *cs_port, uint16_t cs_pin);
+void BMP280_PortSPI_Read(const SPI_BusDevice *spi, uint8_t reg, uint8_t *data, uint16_t size);
+void BMP280_PortSPI_Write(const SPI_BusDevice *spi, uint8_t reg, uint8_t value);
 void BMP280_SPI_CS_Select(void);
 void BMP280_SPI_CS_Deselect(void);
+HAL_StatusTypeDef BMP280_PortSPI_TransferDMA(const SPI_BusDevice *spi, const uint8_t *tx, uint8_t *rx, uint16_t size,
+                                             BMP280_PortSPI_Callback callback, void *context);
+#if BMP280_PORT_BENCHMARK
+void BMP280_PortSPI_Benchmark(const SPI_BusDevice *spi, BMP280_PortBenchmark *result);
+#endif
 
 #endif /* API_INC_BMP280_PORT_H_ */
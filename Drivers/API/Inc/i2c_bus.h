@@ -0,0 +1,61 @@
+/*
+ * i2c_bus.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ */
+
+#ifndef API_INC_I2C_BUS_H_
+#define API_INC_I2C_BUS_H_
+
+#include "stm32f4xx_hal.h"
+#include "stdbool.h"
+#include "stdint.h"
+typedef bool bool_t;
+
+// Pending transactions per bus (including the active one)
+#define I2C_BUS_QUEUE_LENGTH   8
+#define I2C_BUS1_CLOCK_SPEED   100000   // PCF8574 (LCD): standard mode only
+#define I2C_BUS3_CLOCK_SPEED   400000   // MPU6050: fast mode, needed to drain the FIFO at 1 kHz
+
+typedef enum
+{
+    I2C_BUS_1 = 0,     // PB6/PB7 (LCD)
+    I2C_BUS_3,         // PA8/PC9 (MPU6050)
+    I2C_BUS_COUNT
+} I2C_BusId;
+
+typedef enum
+{
+    I2C_XFER_TRANSMIT = 0,
+    I2C_XFER_MEM_READ,
+    I2C_XFER_MEM_WRITE
+} I2C_XferType;
+
+typedef void (*I2C_XferCallback)(HAL_StatusTypeDef status, void *context);
+
+typedef struct
+{
+    I2C_XferType     type;
+    uint16_t         dev_addr;   // 7-bit address << 1
+    uint16_t         mem_addr;   // only MEM_READ / MEM_WRITE (8-bit register)
+    uint8_t          *data;      // must stay valid until the callback
+    uint16_t         size;
+    I2C_XferCallback callback;   // called from interrupt context, may be NULL
+    void             *context;
+} I2C_Transaction;
+
+extern void Error_Handler(void);
+
+void I2C_Bus_Init(I2C_BusId bus);
+I2C_HandleTypeDef *I2C_Bus_GetHandle(I2C_BusId bus);
+bool_t I2C_Bus_Submit(I2C_BusId bus, const I2C_Transaction *xfer);
+HAL_StatusTypeDef I2C_Bus_Transfer(I2C_BusId bus, const I2C_Transaction *xfer);
+bool_t I2C_Bus_IsIdle(I2C_BusId bus);
+
+void I2C_Bus_EV_IRQHandler(I2C_BusId bus);
+void I2C_Bus_ER_IRQHandler(I2C_BusId bus);
+void I2C_Bus_DMA_RxIRQHandler(I2C_BusId bus);
+void I2C_Bus_DMA_TxIRQHandler(I2C_BusId bus);
+
+#endif /* API_INC_I2C_BUS_H_ */
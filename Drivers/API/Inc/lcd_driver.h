@@ -10,6 +10,8 @@
 
 #include "stm32f4xx_hal.h"
 #include "stdint.h"
+#include "stdbool.h"
+typedef bool bool_t;
 
 
 
@@ -65,12 +67,44 @@
 
 #define FUNCTION_SET_8BIT       0x30
 
+// DDRAM ADDRESS WRAP (2-line mode)
+#define LCD_DDRAM_LINE0_END     0x28
+#define LCD_DDRAM_LINE1_END     0x68
+
+// HD44780 TIMING (us)
+#define LCD_T_ENABLE_US         1       // PW_EH >= 450 ns
+#define LCD_T_EXEC_US           37      // most instructions / data write
+#define LCD_T_EXEC_LONG_US      1520    // clear display / return home
+#define LCD_T_INIT_8BIT_US      4100    // after first 8-bit function set
+#define LCD_T_INIT_SHORT_US     100     // after second 8-bit function set
+#define LCD_T_POWER_ON_MS       40      // > 40 ms after VCC reaches 2.7 V (HAL_Delay adds 1 tick)
+
+// SHADOW FRAMEBUFFER
+#define LCD_MAX_COLS            20
+#define LCD_MAX_ROWS            4
+// Matching cells that are rewritten instead of sending a new SETDDRAMADDR
+#define LCD_DIFF_MAX_GAP        1
+
+// PCF8574 BYTE STREAM
+#define LCD_STREAM_BYTES_PER_NIBBLE  2    // EN high + EN low
+#define LCD_STREAM_BYTES_PER_CHAR    (2 * LCD_STREAM_BYTES_PER_NIBBLE)
+// Full screen: one SETDDRAMADDR + LCD_MAX_COLS characters per row
+#define LCD_STREAM_SIZE              (LCD_MAX_ROWS * (LCD_MAX_COLS + 1) * LCD_STREAM_BYTES_PER_CHAR)
+
 typedef struct
 {
 	uint8_t I2C_LCD_nCol;
 	uint8_t I2C_LCD_nRow;
 } I2C_LCD_Conf;
 
+// Values shown by the background renderer (x100 fixed point)
+typedef struct
+{
+	int16_t temp_x100;
+	int32_t gx_x100;
+	int32_t ax_x100;
+} LCD_SensorSnapshot;
+
 extern void Error_Handler(void);
 
 void LCD_Begin(uint8_t cols, uint8_t row);
@@ -79,6 +113,9 @@ void LCD_Clear(void);
 void LCD_Home(void);
 void LCD_SetCursor(uint8_t col, uint8_t row);
 void LCD_Print(char *str);
-void LCD_PrintSensorData(int16_t temp_x100, int16_t gx_x100, int16_t ax_x100);
+void LCD_PrintSensorData(int16_t temp_x100, int32_t gx_x100, int32_t ax_x100);
+void LCD_SubmitSensorData(const LCD_SensorSnapshot *snapshot);
+void LCD_RenderProcess(void);
+bool_t LCD_RenderIsBusy(void);
 
 #endif /* API_INC_LCD_DRIVER_H_ */
@@ -10,13 +10,18 @@
 
 #include "stm32f4xx_hal.h"
 #include "lcd_driver.h"
+#include "i2c_bus.h"
 #include "stdint.h"
 
+#define LCD_I2C_BUS  I2C_BUS_1
+
 extern void Error_Handler(void);
 
 void LCD_PortI2C_Init();
 void LCD_PortI2C_Isready();
-void LCD_PortI2C_WriteRegister(uint8_t  valor);
+void LCD_PortI2C_WriteRegister(uint8_t valor);
+void LCD_PortI2C_WriteStream(uint8_t *data, uint16_t size);
+bool_t LCD_PortI2C_WriteAsync(uint8_t *data, uint16_t size, I2C_XferCallback callback, void *context);
 void BMP280_SPI_CS_Select(void);
 void BMP280_SPI_CS_Deselect(void);
 
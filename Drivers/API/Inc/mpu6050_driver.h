@@ -10,6 +10,7 @@
 
 #include "stdbool.h"
 #include "stdint.h"
+#include "i2c_bus.h"
 typedef bool bool_t;
 
 // Length data register Measurements
@@ -21,8 +22,13 @@ typedef bool bool_t;
 #define MAX_BYTE_REGISTER 1
 #define MAX_BYTE_SEND     1
 
-// MPU6050 I2C address (AD=0)
-#define ADDRESS_MPU6050  0x68
+// MPU6050 I2C address, selected by the AD0 pin
+#define MPU6050_ADDRESS_AD0_LOW   0x68
+#define MPU6050_ADDRESS_AD0_HIGH  0x69
+#define ADDRESS_MPU6050           MPU6050_ADDRESS_AD0_LOW
+
+// WHO_AM_I content, independent of AD0
+#define MPU6050_WHO_AM_I_VALUE    0x68
 
 // Gyroscope Configuration
 #define GYRO_CONFIG      0x1B
@@ -53,9 +59,27 @@ typedef bool bool_t;
 #define FS_LSB_ACC_1000  4096.0f
 #define FS_LSB_ACC_2000  2048.0f
 
+// Fixed-point scaling for the *Int API: value_x100 = (raw * K + Q_ROUND) >> Q_SHIFT,
+// K = round(100 / LSB_per_unit * 2^12). Max |raw * K| = 32768 * 24976 < 2^31.
+#define MPU6050_Q_SHIFT  12
+#define MPU6050_Q_ROUND  (1 << (MPU6050_Q_SHIFT - 1))
+
+#define Q12_GYRO_250_X100   3127    // 100 / 131
+#define Q12_GYRO_500_X100   6253    // 100 / 65.5
+#define Q12_GYRO_1000_X100  12488   // 100 / 32.8
+#define Q12_GYRO_2000_X100  24976   // 100 / 16.4
+
+#define Q12_ACC_2G_X100     25      // 100 / 16384 (exact)
+#define Q12_ACC_4G_X100     50      // 100 / 8192  (exact)
+#define Q12_ACC_8G_X100     100     // 100 / 4096  (exact)
+#define Q12_ACC_16G_X100    200     // 100 / 2048  (exact)
+
+#define Q12_TEMP_X100       1205    // 100 / 340
+#define TEMP_OFFSET_X100    3653    // 36.53 °C
+
+
 //Sample Rate
 #define SMPLRT_DIV       0x19
-#define CONF_SMPLRT_DIV  0x00
 
 // Power Management
 #define PWR_MGMT_1       0x6B
@@ -63,7 +87,10 @@ typedef bool bool_t;
 
 // Configuration
 #define CONFIG           0x1A
-#define CONFIG_DLPF      0x03
+
+// Gyro output rate feeding SMPLRT_DIV (Hz): 8 kHz with the DLPF off, 1 kHz otherwise
+#define MPU6050_GYRO_RATE_DLPF_OFF  8000
+#define MPU6050_GYRO_RATE_DLPF_ON   1000
 
 // Temperature Measurements
 #define TEMP_OUT_H       0x41
@@ -74,6 +101,38 @@ typedef bool bool_t;
 // Accelerometer Measurements
 #define ACCEL_XOUT_H     0x3B
 
+// Burst Measurements (ACCEL_XOUT_H .. GYRO_ZOUT_L)
+#define MPU6050_BURST_LENGTH 14
+
+// FIFO
+#define FIFO_EN          0x23
+#define FIFO_EN_TEMP     0x80
+#define FIFO_EN_XG       0x40
+#define FIFO_EN_YG       0x20
+#define FIFO_EN_ZG       0x10
+#define FIFO_EN_ACCEL    0x08
+// Same layout as the burst: accel, temp, gyro
+#define FIFO_EN_ALL      (FIFO_EN_TEMP | FIFO_EN_XG | FIFO_EN_YG | FIFO_EN_ZG | FIFO_EN_ACCEL)
+
+#define USER_CTRL        0x6A
+#define USER_CTRL_FIFO_EN    0x40
+#define USER_CTRL_FIFO_RESET 0x04
+
+#define INT_PIN_CFG      0x37
+#define INT_PIN_CFG_RD_CLEAR 0x10   // active high, push-pull, 50 us pulse, cleared by any read
+
+#define INT_ENABLE       0x38
+#define INT_STATUS       0x3A
+#define INT_FIFO_OFLOW   0x10
+#define INT_DATA_RDY     0x01
+
+#define FIFO_COUNTH      0x72
+#define FIFO_R_W         0x74
+
+#define MPU6050_FIFO_SIZE        1024
+#define MPU6050_FIFO_FRAME_SIZE  MPU6050_BURST_LENGTH
+#define MPU6050_FIFO_MAX_FRAMES  (MPU6050_FIFO_SIZE / MPU6050_FIFO_FRAME_SIZE)
+
 // Vector structure
 
 typedef struct {
@@ -90,10 +149,164 @@ typedef struct
 
 }Vector3i16;
 
-#define ADDRESS_MPU6050 0x68
+typedef struct
+{
+    int32_t x;
+    int32_t y;
+    int32_t z;
+} Vector3i32;
+
+// Coherent raw sample (same sampling instant for all fields)
+
+typedef struct
+{
+    Vector3i16 accel;
+    int16_t    temp;
+    Vector3i16 gyro;
+} MPU6050_RawSample;
+
+// Asynchronous (I2C DMA) acquisition state
+
+typedef enum
+{
+    MPU6050_ACQ_IDLE = 0,
+    MPU6050_ACQ_BUSY,
+    MPU6050_ACQ_READY,
+    MPU6050_ACQ_ERROR
+} MPU6050_AcqState;
+
+// Runtime configuration (MPU6050_Configure)
+
+typedef enum
+{
+    MPU6050_GYRO_250DPS = 0,
+    MPU6050_GYRO_500DPS,
+    MPU6050_GYRO_1000DPS,
+    MPU6050_GYRO_2000DPS
+} MPU6050_GyroRange;
+
+typedef enum
+{
+    MPU6050_ACC_2G = 0,
+    MPU6050_ACC_4G,
+    MPU6050_ACC_8G,
+    MPU6050_ACC_16G
+} MPU6050_AccRange;
+
+// Accelerometer bandwidth (the gyro one is slightly lower), DLPF_CFG value
+typedef enum
+{
+    MPU6050_DLPF_260HZ = 0,   // filter off, 8 kHz gyro output
+    MPU6050_DLPF_184HZ,
+    MPU6050_DLPF_94HZ,
+    MPU6050_DLPF_44HZ,
+    MPU6050_DLPF_21HZ,
+    MPU6050_DLPF_10HZ,
+    MPU6050_DLPF_5HZ
+} MPU6050_Dlpf;
+
+typedef struct
+{
+    MPU6050_GyroRange gyro_range;
+    MPU6050_AccRange  acc_range;
+    MPU6050_Dlpf      dlpf;
+    uint16_t          sample_rate_hz;   // rounded to the closest rate reachable with SMPLRT_DIV
+} MPU6050_Config;
+
+// Configuration applied by MPU6050_Init()
+#define MPU6050_CONFIG_DEFAULT  { MPU6050_GYRO_250DPS, MPU6050_ACC_2G, MPU6050_DLPF_44HZ, 1000 }
 
+typedef struct mpu6050_dev mpu6050_dev_t;
+
+// Called from interrupt context with every sample acquired on data-ready
+typedef void (*MPU6050_SampleCallback)(mpu6050_dev_t *dev, const MPU6050_RawSample *sample, uint32_t timestamp_us);
+
+// Bus and 7-bit address of one sensor
+typedef struct
+{
+    I2C_BusId bus;
+    uint8_t   address;
+} MPU6050_PortI2C;
+
+// EXTI line wired to the INT pin (port == NULL if not connected)
+typedef struct
+{
+    GPIO_TypeDef *port;
+    uint16_t     pin;
+    IRQn_Type    irq;
+} MPU6050_PortINT;
+
+// One sensor: bus/address, scaling, sample cache and acquisition/FIFO state
+struct mpu6050_dev
+{
+    MPU6050_PortI2C   i2c;
+    MPU6050_PortINT   int_line;
+
+    MPU6050_Config    config;
+    float             gyro_lsb, acc_lsb;
+    int32_t           gyro_q12, acc_q12;
+
+    MPU6050_RawSample sample_cache;
+    uint8_t           sample_unread;
+    uint32_t          sample_timestamp_us;
+
+    // Asynchronous burst; acq_sample is already parsed so acq_buf can be refilled meanwhile
+    uint8_t                   acq_buf[MPU6050_BURST_LENGTH];
+    volatile MPU6050_AcqState acq_state;
+    MPU6050_RawSample         acq_sample;
+    volatile bool_t           acq_sample_new;
+    uint32_t                  acq_start_us;
+    uint32_t                  acq_timestamp_us;
+
+    MPU6050_SampleCallback dataready_callback;
+    bool_t                 dataready_enabled;
+    uint32_t               dataready_missed;
+
+    // FIFO drain: INT_STATUS -> FIFO_COUNT -> FIFO_R_W (or reset after an overflow)
+    uint8_t                   fifo_status;
+    uint8_t                   fifo_count_buf[2];
+    uint8_t                   fifo_ctrl;
+    uint8_t                   fifo_buf[MPU6050_FIFO_MAX_FRAMES * MPU6050_FIFO_FRAME_SIZE];
+    uint16_t                  fifo_frames;
+    volatile bool_t           fifo_overflow;
+    volatile MPU6050_AcqState fifo_state;
+    bool_t                    fifo_enabled;
+    uint32_t                  fifo_overflow_count;
+};
+
+// Handle-based API (several sensors, any bus / AD0 address)
+bool_t MPU6050_DevInit(mpu6050_dev_t *dev, I2C_BusId bus, uint8_t address);
+void  MPU6050_DevSetIntLine(mpu6050_dev_t *dev, GPIO_TypeDef *port, uint16_t pin, IRQn_Type irq);
+bool_t MPU6050_DevIsAvailable(mpu6050_dev_t *dev);
+bool_t MPU6050_DevConfigure(mpu6050_dev_t *dev, const MPU6050_Config *config);
+void  MPU6050_DevGetConfig(const mpu6050_dev_t *dev, MPU6050_Config *config);
+float MPU6050_DevGetTemperature(mpu6050_dev_t *dev);
+Vector3f MPU6050_DevGetGyroscope(mpu6050_dev_t *dev);
+Vector3f MPU6050_DevGetAccelerometer(mpu6050_dev_t *dev);
+int16_t MPU6050_DevGetTemperatureInt(mpu6050_dev_t *dev);
+Vector3i32 MPU6050_DevGetGyroscopeInt(mpu6050_dev_t *dev);
+Vector3i32 MPU6050_DevGetAccelerometerInt(mpu6050_dev_t *dev);
+void MPU6050_DevReadAll(mpu6050_dev_t *dev, MPU6050_RawSample *sample);
+bool_t MPU6050_DevStartAcquisition(mpu6050_dev_t *dev);
+MPU6050_AcqState MPU6050_DevGetAcquisitionState(const mpu6050_dev_t *dev);
+bool_t MPU6050_DevGetAcquisitionResult(mpu6050_dev_t *dev, MPU6050_RawSample *sample);
+uint32_t MPU6050_DevGetAcquisitionTimestamp(const mpu6050_dev_t *dev);
+void MPU6050_DevDataReadyEnable(mpu6050_dev_t *dev, MPU6050_SampleCallback callback);
+void MPU6050_DevDataReadyDisable(mpu6050_dev_t *dev);
+uint32_t MPU6050_DevDataReadyGetMissedCount(const mpu6050_dev_t *dev);
+void MPU6050_DevFifoEnable(mpu6050_dev_t *dev);
+void MPU6050_DevFifoDisable(mpu6050_dev_t *dev);
+bool_t MPU6050_DevFifoStartDrain(mpu6050_dev_t *dev);
+MPU6050_AcqState MPU6050_DevFifoGetState(const mpu6050_dev_t *dev);
+uint16_t MPU6050_DevFifoGetBatch(mpu6050_dev_t *dev, MPU6050_RawSample *samples, uint16_t max, bool_t *overflow);
+uint16_t MPU6050_DevFifoRead(mpu6050_dev_t *dev, MPU6050_RawSample *samples, uint16_t max, bool_t *overflow);
+uint32_t MPU6050_DevFifoGetOverflowCount(const mpu6050_dev_t *dev);
+
+// Single-sensor API (default sensor: I2C3, AD0 low, INT on MPU6050_INT_PIN)
 void  MPU6050_Init();
 void  MPU6050_Check();
+bool_t MPU6050_Configure(const MPU6050_Config *config);
+void  MPU6050_GetConfig(MPU6050_Config *config);
 // Float Measurements
 float MPU6050_GetTemperature();
 Vector3f  MPU6050_GetGyroscope();
@@ -101,8 +314,31 @@ Vector3f  MPU6050_GetAccelerometer();
 
 // Int Measurements
 int16_t MPU6050_GetTemperatureInt();
-Vector3i16  MPU6050_GetGyroscopeInt();
-Vector3i16  MPU6050_GetAccelerometerInt();
+Vector3i32  MPU6050_GetGyroscopeInt();
+Vector3i32  MPU6050_GetAccelerometerInt();
+
+// Burst Measurements
+void MPU6050_ReadAll(MPU6050_RawSample *sample);
+
+// Asynchronous (I2C DMA) acquisition
+bool_t MPU6050_StartAcquisition();
+MPU6050_AcqState MPU6050_GetAcquisitionState();
+bool_t MPU6050_GetAcquisitionResult(MPU6050_RawSample *sample);
+uint32_t MPU6050_GetAcquisitionTimestamp();
+
+// Data-ready interrupt driven acquisition
+void MPU6050_DataReadyEnable(MPU6050_SampleCallback callback);
+void MPU6050_DataReadyDisable();
+uint32_t MPU6050_DataReadyGetMissedCount();
+
+// FIFO streaming
+void MPU6050_FifoEnable();
+void MPU6050_FifoDisable();
+bool_t MPU6050_FifoStartDrain();
+MPU6050_AcqState MPU6050_FifoGetState();
+uint16_t MPU6050_FifoGetBatch(MPU6050_RawSample *samples, uint16_t max, bool_t *overflow);
+uint16_t MPU6050_FifoRead(MPU6050_RawSample *samples, uint16_t max, bool_t *overflow);
+uint32_t MPU6050_FifoGetOverflowCount();
 
 bool_t MPU6050_IsAvailable();
 
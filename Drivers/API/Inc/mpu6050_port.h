@@ -10,13 +10,27 @@
 
 #include "stm32f4xx_hal.h"
 #include "mpu6050_driver.h"
+#include "i2c_bus.h"
 #include <stdint.h>
 
+#define MPU6050_I2C_BUS  I2C_BUS_3
+
+// INT pin of the MPU6050 (D4 on the Nucleo header)
+#define MPU6050_INT_PIN        GPIO_PIN_5
+#define MPU6050_INT_GPIO_PORT  GPIOB
+#define MPU6050_INT_IRQn       EXTI9_5_IRQn
+
+typedef void (*MPU6050_PortINT_Callback)(void *context);
+
 extern void Error_Handler(void);
 
-void MPU6050_PortI2C_Init();
-void MPU6050_PortI2C_IsReady();
-void MPU6050_PortI2C_WriteRegister(uint8_t reg, uint8_t value, uint8_t MAX_SIZE);
-void MPU6050_PortI2C_ReadRegister(uint8_t reg, uint8_t* buffer, uint8_t MAX_SIZE, uint8_t length);
+void MPU6050_PortI2C_Init(I2C_BusId bus);
+void MPU6050_PortI2C_IsReady(const MPU6050_PortI2C *i2c);
+void MPU6050_PortI2C_WriteRegister(const MPU6050_PortI2C *i2c, uint8_t reg, uint8_t value, uint8_t MAX_SIZE);
+void MPU6050_PortI2C_ReadRegister(const MPU6050_PortI2C *i2c, uint8_t reg, uint8_t* buffer, uint8_t MAX_SIZE, uint16_t length);
+bool_t MPU6050_PortI2C_ReadRegisterAsync(const MPU6050_PortI2C *i2c, uint8_t reg, uint8_t* buffer, uint16_t length, I2C_XferCallback callback, void *context);
+bool_t MPU6050_PortI2C_WriteRegisterAsync(const MPU6050_PortI2C *i2c, uint8_t reg, uint8_t* value, I2C_XferCallback callback, void *context);
+void MPU6050_PortINT_Init(const MPU6050_PortINT *line, MPU6050_PortINT_Callback callback, void *context);
+void MPU6050_PortINT_Disable(const MPU6050_PortINT *line);
 
 #endif /* API_INC_MPU6050_PORT_H_ */
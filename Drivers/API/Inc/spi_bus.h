@@ -0,0 +1,72 @@
+/*
+ * spi_bus.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ */
+
+#ifndef API_INC_SPI_BUS_H_
+#define API_INC_SPI_BUS_H_
+
+#include "stm32f4xx_hal.h"
+#include "stdbool.h"
+#include "stdint.h"
+typedef bool bool_t;
+
+// SPI2: PB10 SCK, PC1 MOSI, PC2 MISO (APB1)
+#define SPI_BUS_INSTANCE      SPI2
+// Pending transactions (including the active one)
+#define SPI_BUS_QUEUE_LENGTH  8
+
+typedef enum
+{
+    SPI_BUS_MODE_0 = 0,   // CPOL 0, CPHA 0
+    SPI_BUS_MODE_1,       // CPOL 0, CPHA 1
+    SPI_BUS_MODE_2,       // CPOL 1, CPHA 0
+    SPI_BUS_MODE_3        // CPOL 1, CPHA 1
+} SPI_BusMode;
+
+// One chip on the bus; filled by SPI_Bus_DeviceInit and must outlive its transactions
+typedef struct
+{
+    GPIO_TypeDef *cs_port;      // GPIO clock enabled by MX_GPIO_Init
+    uint16_t     cs_pin;
+    uint32_t     max_clock_hz;  // datasheet SCK limit
+    SPI_BusMode  mode;
+    uint32_t     cr1;           // CR1 BR/CPOL/CPHA bits for this device
+    uint32_t     clock_hz;      // actual SCK with the chosen prescaler
+} SPI_BusDevice;
+
+typedef void (*SPI_XferCallback)(HAL_StatusTypeDef status, void *context);
+
+typedef struct
+{
+    const SPI_BusDevice *device;
+    const uint8_t       *tx;       // NULL: receive only (the rx buffer is clocked out)
+    uint8_t             *rx;       // NULL: transmit only
+    uint16_t            size;      // buffers must stay valid until the callback
+    SPI_XferCallback    callback;  // called from interrupt context with CS already released, may be NULL
+    void                *context;
+} SPI_Transaction;
+
+extern void Error_Handler(void);
+
+void SPI_Bus_Init(void);
+bool_t SPI_Bus_DeviceInit(SPI_BusDevice *dev, GPIO_TypeDef *cs_port, uint16_t cs_pin,
+                          uint32_t max_clock_hz, SPI_BusMode mode);
+SPI_HandleTypeDef *SPI_Bus_GetHandle(void);
+bool_t SPI_Bus_Submit(const SPI_Transaction *xfer);
+HAL_StatusTypeDef SPI_Bus_Transfer(const SPI_Transaction *xfer);
+bool_t SPI_Bus_IsIdle(void);
+
+// Exclusive access for polled transfers (main loop only)
+void SPI_Bus_Acquire(const SPI_BusDevice *dev);
+void SPI_Bus_Release(void);
+void SPI_Bus_Select(const SPI_BusDevice *dev);
+void SPI_Bus_Deselect(const SPI_BusDevice *dev);
+
+void SPI_Bus_IRQHandler(void);
+void SPI_Bus_DMA_RxIRQHandler(void);
+void SPI_Bus_DMA_TxIRQHandler(void);
+
+#endif /* API_INC_SPI_BUS_H_ */
@@ -0,0 +1,102 @@
+/*
+ * API_altitude.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ */
+
+#include "API_altitude.h"
+
+#define TABLE_SCALE  ((float)ALTITUDE_TABLE_STEPS / (ALTITUDE_RATIO_MAX - ALTITUDE_RATIO_MIN))
+
+/*
+ * altitude_table[i] = 44330 * (1 - x^0.1903), x = 0.25 + i / 256 (metros).
+ * Generada en el host en doble precisión; x = 1 (i = 192) es exactamente 0 m.
+ */
+static const float altitude_table[ALTITUDE_TABLE_STEPS + 1] = {
+	10279.3258f, 10178.7128f, 10079.3453f, 9981.1896f, 9884.2130f, 9788.3843f,
+	9693.6737f, 9600.0523f, 9507.4926f, 9415.9680f, 9325.4530f, 9235.9230f,
+	9147.3545f, 9059.7246f, 8973.0114f, 8887.1937f, 8802.2511f, 8718.1640f,
+	8634.9132f, 8552.4805f, 8470.8481f, 8389.9988f, 8309.9160f, 8230.5837f,
+	8151.9863f, 8074.1089f, 7996.9367f, 7920.4557f, 7844.6523f, 7769.5131f,
+	7695.0253f, 7621.1763f, 7547.9541f, 7475.3470f, 7403.3434f, 7331.9322f,
+	7261.1028f, 7190.8446f, 7121.1473f, 7052.0012f, 6983.3965f, 6915.3239f,
+	6847.7742f, 6780.7386f, 6714.2083f, 6648.1750f, 6582.6304f, 6517.5665f,
+	6452.9754f, 6388.8497f, 6325.1818f, 6261.9646f, 6199.1909f, 6136.8538f,
+	6074.9467f, 6013.4629f, 5952.3960f, 5891.7398f, 5831.4882f, 5771.6351f,
+	5712.1748f, 5653.1014f, 5594.4095f, 5536.0936f, 5478.1482f, 5420.5683f,
+	5363.3486f, 5306.4843f, 5249.9703f, 5193.8019f, 5137.9745f, 5082.4834f,
+	5027.3241f, 4972.4922f, 4917.9835f, 4863.7936f, 4809.9185f, 4756.3541f,
+	4703.0965f, 4650.1416f, 4597.4857f, 4545.1251f, 4493.0561f, 4441.2750f,
+	4389.7784f, 4338.5627f, 4287.6246f, 4236.9608f, 4186.5679f, 4136.4427f,
+	4086.5820f, 4036.9829f, 3987.6422f, 3938.5569f, 3889.7241f, 3841.1410f,
+	3792.8046f, 3744.7122f, 3696.8611f, 3649.2485f, 3601.8719f, 3554.7286f,
+	3507.8161f, 3461.1318f, 3414.6734f, 3368.4383f, 3322.4243f, 3276.6288f,
+	3231.0497f, 3185.6847f, 3140.5315f, 3095.5879f, 3050.8518f, 3006.3211f,
+	2961.9936f, 2917.8672f, 2873.9401f, 2830.2100f, 2786.6752f, 2743.3336f,
+	2700.1834f, 2657.2226f, 2614.4495f, 2571.8622f, 2529.4588f, 2487.2377f,
+	2445.1971f, 2403.3353f, 2361.6505f, 2320.1412f, 2278.8057f, 2237.6423f,
+	2196.6495f, 2155.8257f, 2115.1693f, 2074.6789f, 2034.3529f, 1994.1898f,
+	1954.1882f, 1914.3466f, 1874.6636f, 1835.1378f, 1795.7678f, 1756.5522f,
+	1717.4898f, 1678.5791f, 1639.8188f, 1601.2078f, 1562.7446f, 1524.4280f,
+	1486.2569f, 1448.2298f, 1410.3457f, 1372.6034f, 1335.0016f, 1297.5393f,
+	1260.2152f, 1223.0282f, 1185.9772f, 1149.0611f, 1112.2788f, 1075.6292f,
+	1039.1112f, 1002.7239f, 966.4661f, 930.3369f, 894.3352f, 858.4600f,
+	822.7103f, 787.0852f, 751.5837f, 716.2048f, 680.9476f, 645.8111f,
+	610.7945f, 575.8968f, 541.1172f, 506.4547f, 471.9084f, 437.4776f,
+	403.1612f, 368.9586f, 334.8688f, 300.8911f, 267.0245f, 233.2684f,
+	199.6218f, 166.0840f, 132.6542f, 99.3317f, 66.1157f, 33.0054f,
+	0.0000f, -32.9011f, -65.6988f, -98.3936f, -130.9864f, -163.4779f,
+	-195.8687f, -228.1596f, -260.3512f, -292.4443f, -324.4394f, -356.3373f,
+	-388.1386f, -419.8439f, -451.4540f, -482.9694f, -514.3908f, -545.7188f,
+	-576.9540f, -608.0970f, -639.1485f, -670.1090f, -700.9792f, -731.7595f,
+	-762.4507f, -793.0533f, -823.5677f, -853.9948f, -884.3348f, -914.5885f,
+	-944.7564f, -974.8389f, -1004.8368f, -1034.7504f, -1064.5803f, -1094.3270f,
+	-1123.9911f, -1153.5730f, -1183.0733f, -1212.4925f, -1241.8310f, -1271.0894f,
+	-1300.2682f, -1329.3677f, -1358.3886f, -1387.3312f, -1416.1961f, -1444.9837f,
+	-1473.6944f, -1502.3288f, -1530.8873f, -1559.3703f, -1587.7783f, -1616.1117f,
+	-1644.3710f, -1672.5566f, -1700.6688f, -1728.7082f, -1756.6752f, -1784.5701f,
+	-1812.3934f, -1840.1455f, -1867.8269f, -1895.4378f, -1922.9787f,
+};
+
+static float altitudeFromRatio(float ratio);
+
+/*
+ * Interpola linealmente el tramo de la tabla que contiene ratio = p / p0.
+ * Fuera de [0.25, 1.25] se usa el tramo extremo (extrapolación lineal).
+ */
+static float altitudeFromRatio(float ratio)
+{
+	float t = (ratio - ALTITUDE_RATIO_MIN) * TABLE_SCALE;
+	int32_t i = (int32_t)t;
+
+	if (t < 0.0f) i = 0;
+	if (i > ALTITUDE_TABLE_STEPS - 1) i = ALTITUDE_TABLE_STEPS - 1;
+
+	float frac = t - (float)i;
+	return altitude_table[i] + frac * (altitude_table[i + 1] - altitude_table[i]);
+}
+
+/*
+ * Altitud en metros a partir de la presión medida y la de referencia a nivel del mar (hPa).
+ * Reemplaza a 44330 * (1 - powf(p / p0, 0.1903f)): una división, una conversión a entero y
+ * una interpolación, en lugar de la powf de libm.
+ */
+float altitudeFromPressure(float pressure_hpa, float sea_level_hpa)
+{
+	return altitudeFromRatio(pressure_hpa / sea_level_hpa);
+}
+
+/*
+ * Convierte un arreglo de presiones (hPa) en altitudes (m), por ejemplo para registrar o filtrar
+ * un lote de muestras. 1 / p0 se calcula una sola vez: cada elemento cuesta una multiplicación
+ * y una interpolación. pressure_hpa y altitude_m pueden ser el mismo arreglo.
+ */
+void altitudeFromPressureBatch(const float *pressure_hpa, float *altitude_m, uint16_t count, float sea_level_hpa)
+{
+	float inv_p0 = 1.0f / sea_level_hpa;
+
+	for (uint16_t i = 0; i < count; i++) {
+		altitude_m[i] = altitudeFromRatio(pressure_hpa[i] * inv_p0);
+	}
+}
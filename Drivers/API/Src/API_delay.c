@@ -0,0 +1,116 @@
+/*
+ * API_delay.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ */
+
+
+#include "API_delay.h"
+
+#define CYCLES_PER_US (SystemCoreClock / 1000000U)
+
+/**
+ * @brief Habilita el contador de ciclos DWT (CYCCNT) del Cortex-M4.
+ *
+ * El contador avanza a la frecuencia del núcleo (84 MHz en este proyecto), lo que da una
+ * resolución de ~12 ns para los retardos de `delayUs()`.
+ *
+ * @return `true` si el contador quedó funcionando, `false` si el núcleo no lo implementa.
+ *
+ * @details
+ * 1. Se habilita el bloque de traza con `CoreDebug->DEMCR.TRCENA`.
+ * 2. Se pone a cero `DWT->CYCCNT` y se habilita con `DWT_CTRL_CYCCNTENA`.
+ * 3. Se verifica que el contador avance.
+ *
+ * @note
+ * - Puede llamarse más de una vez; no altera el funcionamiento de `HAL_Delay`.
+ */
+
+bool_t delayUsInit(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+	{
+		DWT->CYCCNT = 0;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	}
+
+	uint32_t start = DWT->CYCCNT;
+	__NOP();
+	__NOP();
+	return (DWT->CYCCNT != start);
+}
+
+/**
+ * @brief Retardo activo con resolución de microsegundos.
+ *
+ * @param us Tiempo de espera en microsegundos.
+ *
+ * @details
+ * Compara la diferencia de `DWT->CYCCNT` con el número de ciclos equivalente. La resta sin signo
+ * hace que el desborde del contador (cada ~51 s a 84 MHz) no afecte la medición.
+ *
+ * @note
+ * - Requiere haber llamado a `delayUsInit()`.
+ * - Para esperas de milisegundos sigue siendo preferible `HAL_Delay`.
+ */
+
+void delayUs(uint32_t us)
+{
+	uint32_t start = DWT->CYCCNT;
+	uint32_t cycles = us * CYCLES_PER_US;
+
+	while ((DWT->CYCCNT - start) < cycles) {
+	}
+}
+
+/**
+ * @brief Devuelve el valor actual del contador de ciclos, útil para medir tiempos de ejecución.
+ *
+ * @return Valor de `DWT->CYCCNT`.
+ */
+
+uint32_t delayGetCycles(void)
+{
+	return DWT->CYCCNT;
+}
+
+/**
+ * @brief Devuelve el tiempo desde el arranque en microsegundos, derivado de SysTick.
+ *
+ * @return Microsegundos transcurridos; desborda cada ~71 minutos, por lo que las comparaciones
+ *         deben hacerse por diferencia (`(int32_t)(a - b)`).
+ *
+ * @details
+ * 1. Combina el contador de milisegundos de la HAL (`HAL_GetTick()`) con la cuenta descendente
+ *    de `SysTick->VAL` dentro del milisegundo actual.
+ * 2. Si la interrupción de SysTick ocurre entre ambas lecturas se repite la lectura.
+ * 3. Si SysTick ya recargó pero su interrupción sigue pendiente (llamada desde otra interrupción
+ *    o con interrupciones deshabilitadas), se suma el milisegundo que la HAL aún no contabilizó.
+ *
+ * @note
+ * - A diferencia de `DWT->CYCCNT` no desborda cada ~51 s, por lo que sirve como base de tiempo
+ *   de larga duración (por ejemplo para el planificador de tareas).
+ * - Válida también en interrupciones (por ejemplo, para marcar el instante de un EXTI), siempre
+ *   que la interrupción de SysTick no quede pendiente más de 1 ms.
+ */
+
+uint32_t delayGetMicros(void)
+{
+	uint32_t ms;
+	uint32_t val;
+	uint32_t tick;
+
+	do {
+		tick = HAL_GetTick();
+		val = SysTick->VAL;
+		ms = tick;
+		if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+			val = SysTick->VAL;
+			ms = tick + 1U;
+		}
+	} while (tick != HAL_GetTick());
+
+	return ms * 1000U + (SysTick->LOAD - val) / CYCLES_PER_US;
+}
@@ -0,0 +1,35 @@
+/*
+ * API_log.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ */
+
+
+#include "API_log.h"
+
+/*
+ * Envía un mensaje tokenizado como frame de telemetría TELEMETRY_TYPE_LOG:
+ *   id u16 | args u32 * count
+ * El formateo lo hace el decodificador en la PC usando el diccionario .log_fmt.
+ * Los argumentos que exceden LOG_MAX_ARGS se descartan.
+ */
+void logEmit(uint16_t id, const uint32_t *args, uint8_t count)
+{
+	uint8_t payload[TELEMETRY_MAX_PAYLOAD];
+	uint8_t size = 0;
+
+	if (count > LOG_MAX_ARGS) count = LOG_MAX_ARGS;
+
+	payload[size++] = (uint8_t)id;
+	payload[size++] = (uint8_t)(id >> 8);
+	for (uint8_t i = 0; i < count; i++)
+	{
+		payload[size++] = (uint8_t)args[i];
+		payload[size++] = (uint8_t)(args[i] >> 8);
+		payload[size++] = (uint8_t)(args[i] >> 16);
+		payload[size++] = (uint8_t)(args[i] >> 24);
+	}
+
+	telemetrySendFrame(TELEMETRY_TYPE_LOG, payload, size);
+}
@@ -0,0 +1,174 @@
+/*
+ * API_scheduler.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ */
+
+
+#include "API_scheduler.h"
+#include <stddef.h>
+#include <string.h>
+
+/*
+ * Planificador cooperativo multi-tasa. Cada tarea se libera cada period_us; entre las tareas
+ * liberadas se ejecuta primero la de vencimiento más próximo (release + period). Las tareas
+ * no se interrumpen entre sí, por lo que deben retornar rápido (sin esperas activas).
+ *
+ * No depende de la HAL: la base de tiempo se inyecta en schedulerInit(), lo que permite
+ * ejecutarlo en la PC con un reloj simulado.
+ */
+
+typedef struct
+{
+	const char        *name;
+	schedulerTaskFn_t fn;
+	void              *context;
+	uint32_t          period_us;
+	uint32_t          release_us;   // próxima liberación (la anterior es release_us - period_us)
+	schedulerStats_t  stats;
+} schedulerTask_t;
+
+static schedulerTask_t tasks[SCHEDULER_MAX_TASKS];
+static uint8_t task_count = 0;
+static schedulerClock_t scheduler_clock = NULL;
+
+static bool_t isDue(uint32_t now, uint32_t time);
+
+
+void schedulerInit(schedulerClock_t clock)
+{
+	scheduler_clock = clock;
+	task_count = 0;
+	memset(tasks, 0, sizeof(tasks));
+}
+
+/*
+ * Registra una tarea periódica. offset_us desplaza la primera liberación, útil para que
+ * tareas con períodos múltiplos no coincidan siempre en el mismo instante.
+ * Retorna el identificador de la tarea o -1 si no hay lugar o los parámetros son inválidos.
+ */
+int8_t schedulerAddTask(const char *name, schedulerTaskFn_t fn, void *context, uint32_t period_us, uint32_t offset_us)
+{
+	if (scheduler_clock == NULL || fn == NULL || period_us == 0 || task_count >= SCHEDULER_MAX_TASKS) return -1;
+
+	schedulerTask_t *task = &tasks[task_count];
+	task->name = name;
+	task->fn = fn;
+	task->context = context;
+	task->period_us = period_us;
+	task->release_us = scheduler_clock() + offset_us;
+	memset(&task->stats, 0, sizeof(task->stats));
+
+	return (int8_t)task_count++;
+}
+
+/*
+ * Cambia el período de una tarea, por ejemplo al reconfigurar el sensor que consulta.
+ * La próxima liberación pasa a ser la anterior + period_us; si ese instante ya pasó, la tarea
+ * se libera de inmediato y la cadencia sigue desde ahí. Puede llamarse desde la propia tarea.
+ * Retorna false si el identificador o el período son inválidos.
+ */
+bool_t schedulerSetPeriod(int8_t id, uint32_t period_us)
+{
+	if (scheduler_clock == NULL || id < 0 || id >= task_count || period_us == 0) return false;
+
+	schedulerTask_t *task = &tasks[id];
+	uint32_t now = scheduler_clock();
+	uint32_t release = task->release_us - task->period_us + period_us;
+
+	task->period_us = period_us;
+	task->release_us = isDue(now, release) ? now : release;
+	return true;
+}
+
+/*
+ * Ejecuta a lo sumo una tarea: la liberada con vencimiento más próximo.
+ * Retorna true si ejecutó alguna tarea.
+ */
+bool_t schedulerRunOnce(void)
+{
+	if (scheduler_clock == NULL) return false;
+
+	uint32_t now = scheduler_clock();
+	schedulerTask_t *next = NULL;
+
+	for (uint8_t i = 0; i < task_count; i++)
+	{
+		schedulerTask_t *task = &tasks[i];
+		if (!isDue(now, task->release_us)) continue;
+
+		if (next == NULL || (int32_t)((task->release_us + task->period_us) - (next->release_us + next->period_us)) < 0)
+		{
+			next = task;
+		}
+	}
+	if (next == NULL) return false;
+
+	uint32_t release = next->release_us;
+	next->release_us += next->period_us;
+
+	uint32_t start = scheduler_clock();
+	next->fn(next->context);
+	uint32_t end = scheduler_clock();
+
+	schedulerStats_t *stats = &next->stats;
+	stats->runs++;
+	stats->last_jitter_us = start - release;
+	stats->last_exec_us = end - start;
+	if (stats->last_jitter_us > stats->max_jitter_us) stats->max_jitter_us = stats->last_jitter_us;
+	if (stats->last_exec_us > stats->max_exec_us) stats->max_exec_us = stats->last_exec_us;
+
+	// Se mantiene la cadencia original; cada liberación que ya pasó cuenta como overrun
+	while (isDue(end, next->release_us))
+	{
+		stats->overruns++;
+		next->release_us += next->period_us;
+	}
+
+	return true;
+}
+
+void schedulerRun(void)
+{
+	while (1)
+	{
+		schedulerRunOnce();
+	}
+}
+
+bool_t schedulerGetStats(int8_t id, schedulerStats_t *stats)
+{
+	if (id < 0 || id >= task_count || stats == NULL) return false;
+
+	*stats = tasks[id].stats;
+	return true;
+}
+
+const char *schedulerGetName(int8_t id)
+{
+	if (id < 0 || id >= task_count) return NULL;
+
+	return tasks[id].name;
+}
+
+uint8_t schedulerGetTaskCount(void)
+{
+	return task_count;
+}
+
+void schedulerResetStats(void)
+{
+	for (uint8_t i = 0; i < task_count; i++)
+	{
+		memset(&tasks[i].stats, 0, sizeof(tasks[i].stats));
+	}
+}
+
+/*
+ * Comparación tolerante al desborde del reloj de 32 bits.
+ */
+static bool_t isDue(uint32_t now, uint32_t time)
+{
+	return (int32_t)(now - time) >= 0;
+}
@@ -0,0 +1,162 @@
+/*
+ * API_telemetry.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ */
+
+
+#include "API_telemetry.h"
+#include "API_uart.h"
+#include <string.h>
+
+#define TELEMETRY_ENV_SIZE  10
+#define TELEMETRY_IMU_SIZE  20
+
+static uint8_t telemetry_seq = 0;
+
+static uint32_t telemetryCrc32(const uint8_t *data, uint16_t size);
+static uint16_t telemetryCobsEncode(const uint8_t *src, uint16_t size, uint8_t *dst);
+static uint8_t *putU16(uint8_t *p, uint16_t value);
+static uint8_t *putU32(uint8_t *p, uint32_t value);
+
+
+bool_t telemetryInit(void)
+{
+	__HAL_RCC_CRC_CLK_ENABLE();
+	telemetry_seq = 0;
+	return true;
+}
+
+/*
+ * Arma el frame (encabezado + payload + CRC), lo codifica con COBS y lo encola en la UART.
+ * No bloquea: retorna false si el payload es demasiado grande. Si el buffer de la UART
+ * está lleno el frame se descarta y queda contabilizado en uartTxStats_t; el número de
+ * secuencia permite al receptor detectar la pérdida.
+ * Puede llamarse desde interrupciones: el uso de la unidad CRC y del número de secuencia
+ * se protege con una sección crítica.
+ */
+bool_t telemetrySendFrame(telemetryType_t type, const uint8_t *payload, uint8_t size)
+{
+	uint8_t frame[TELEMETRY_MAX_FRAME];
+	uint8_t encoded[TELEMETRY_MAX_ENCODED];
+
+	if (size > TELEMETRY_MAX_PAYLOAD || (size > 0 && payload == NULL)) return false;
+
+	uint8_t *p = frame;
+	*p++ = (uint8_t)type;
+	p++;
+	p = putU32(p, HAL_GetTick());
+	memcpy(p, payload, size);
+	p += size;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	frame[1] = telemetry_seq++;
+	p = putU32(p, telemetryCrc32(frame, p - frame));
+	__set_PRIMASK(primask);
+
+	uint16_t length = telemetryCobsEncode(frame, p - frame, encoded);
+	encoded[length++] = 0x00;
+
+	uartSendStringSize(encoded, length);
+	return true;
+}
+
+bool_t telemetrySendEnv(const telemetryEnv_t *env)
+{
+	uint8_t payload[TELEMETRY_ENV_SIZE];
+	uint8_t *p = payload;
+
+	if (env == NULL) return false;
+
+	p = putU16(p, (uint16_t)env->temp_x100);
+	p = putU32(p, env->pressure_pa);
+	p = putU32(p, (uint32_t)env->altitude_cm);
+
+	return telemetrySendFrame(TELEMETRY_TYPE_ENV, payload, sizeof(payload));
+}
+
+bool_t telemetrySendImu(const telemetryImu_t *imu)
+{
+	uint8_t payload[TELEMETRY_IMU_SIZE];
+	uint8_t *p = payload;
+
+	if (imu == NULL) return false;
+
+	p = putU16(p, (uint16_t)imu->temp_x100);
+	for (int i = 0; i < 3; i++) p = putU32(p, (uint32_t)imu->gyro_x100[i]);
+	for (int i = 0; i < 3; i++) p = putU16(p, (uint16_t)imu->accel_x100[i]);
+
+	return telemetrySendFrame(TELEMETRY_TYPE_IMU, payload, sizeof(payload));
+}
+
+/*
+ * CRC-32 por hardware. La unidad procesa palabras de 32 bits, por lo que el último
+ * tramo se completa con ceros; el decodificador hace lo mismo.
+ */
+static uint32_t telemetryCrc32(const uint8_t *data, uint16_t size)
+{
+	CRC->CR = CRC_CR_RESET;
+
+	while (size > 0)
+	{
+		uint32_t word = 0;
+		uint16_t chunk = (size < 4) ? size : 4;
+		memcpy(&word, data, chunk);
+		CRC->DR = word;
+		data += chunk;
+		size -= chunk;
+	}
+
+	return CRC->DR;
+}
+
+/*
+ * Consistent Overhead Byte Stuffing: elimina los 0x00 del frame para poder usar 0x00 como
+ * delimitador. Retorna la longitud codificada (sin el delimitador).
+ */
+static uint16_t telemetryCobsEncode(const uint8_t *src, uint16_t size, uint8_t *dst)
+{
+	uint16_t out = 1;
+	uint16_t code_pos = 0;
+	uint8_t code = 1;
+
+	for (uint16_t i = 0; i < size; i++)
+	{
+		if (src[i] == 0x00)
+		{
+			dst[code_pos] = code;
+			code_pos = out++;
+			code = 1;
+			continue;
+		}
+
+		dst[out++] = src[i];
+		if (++code == 0xFF)
+		{
+			dst[code_pos] = code;
+			code_pos = out++;
+			code = 1;
+		}
+	}
+	dst[code_pos] = code;
+
+	return out;
+}
+
+static uint8_t *putU16(uint8_t *p, uint16_t value)
+{
+	*p++ = (uint8_t)value;
+	*p++ = (uint8_t)(value >> 8);
+	return p;
+}
+
+static uint8_t *putU32(uint8_t *p, uint32_t value)
+{
+	*p++ = (uint8_t)value;
+	*p++ = (uint8_t)(value >> 8);
+	*p++ = (uint8_t)(value >> 16);
+	*p++ = (uint8_t)(value >> 24);
+	return p;
+}
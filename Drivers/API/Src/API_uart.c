@@ -9,13 +9,49 @@
 #include "API_uart.h"
 #include <string.h>
 
-#define UART_TIMEOUT 100
 #define UART_MAX_SIZE 1024
 
 static UART_HandleTypeDef huart2;
+static DMA_HandleTypeDef hdma_usart2_tx;
+static DMA_HandleTypeDef hdma_usart2_rx;
+
+/*
+ * Buffer circular de transmisión. Los bytes en [tx_tail, tx_head) están pendientes; de ellos,
+ * los primeros tx_inflight los está leyendo el DMA. Índices siempre < UART_TX_BUFFER_SIZE.
+ */
+static uint8_t tx_buffer[UART_TX_BUFFER_SIZE];
+static volatile uint16_t tx_head = 0;
+static volatile uint16_t tx_tail = 0;
+static volatile uint16_t tx_used = 0;
+static volatile uint16_t tx_inflight = 0;
+static volatile bool_t tx_active = false;
+static uartTxStats_t tx_stats = {0};
+
+/*
+ * Recepción: el DMA escribe continuamente en rx_dma (modo circular). En cada evento (mitad,
+ * fin de buffer o línea inactiva) se copian los bytes nuevos desde rx_last_pos al frame en
+ * armado; la línea inactiva (IDLE) cierra el frame y lo deja en la cola.
+ */
+static uint8_t rx_dma[UART_RX_DMA_SIZE];
+static uint16_t rx_last_pos = 0;
+static uint8_t rx_frames[UART_RX_FRAME_COUNT][UART_RX_FRAME_SIZE];
+static uint16_t rx_frame_len[UART_RX_FRAME_COUNT];
+static volatile uint8_t rx_head = 0;
+static volatile uint8_t rx_count = 0;
+static uint16_t rx_discarded = 0;
+static bool_t rx_truncated = false;
+static uartRxStats_t rx_stats = {0};
 
 static bool_t checkPointer(const uint8_t *ptr);
 static bool_t checkSize(uint16_t size);
+static bool_t uartTxDmaInit(void);
+static void uartTxEnqueue(const uint8_t *data, uint16_t size);
+static void uartTxStartNext(void);
+static void uartTxRelease(uint16_t size);
+static bool_t uartRxStart(void);
+static void uartRxConsume(uint16_t pos);
+static void uartRxAppend(const uint8_t *data, uint16_t size);
+static void uartRxEndFrame(void);
 
 
 bool_t uartInit(void)
@@ -29,16 +65,14 @@ bool_t uartInit(void)
 	  huart2.Init.HwFlowCtl = UART_HWCONTROL_NONE;
 	  huart2.Init.OverSampling = UART_OVERSAMPLING_16;
 
-	  if (HAL_UART_Init(&huart2) != HAL_OK)
+	  if (HAL_UART_Init(&huart2) != HAL_OK || !uartTxDmaInit() || !uartRxStart())
 	  {
 		  return false;
 	  }
 
 	  else
 	  {
-		  const char *msg = "Uart inicializada a 115200, 8N1\r\n";
-
-		  HAL_UART_Transmit(&huart2, (uint8_t *) msg , strlen(msg), HAL_MAX_DELAY);
+		  uartSendString((uint8_t *)"Uart inicializada a 115200, 8N1\r\n");
 
 		  return true;
 	  }
@@ -47,6 +81,60 @@ bool_t uartInit(void)
 
 }
 
+/*
+ * USART2_RX -> DMA1 Stream5 Channel4
+ * USART2_TX -> DMA1 Stream6 Channel4
+ */
+static bool_t uartTxDmaInit(void)
+{
+	__HAL_RCC_DMA1_CLK_ENABLE();
+
+	hdma_usart2_rx.Instance = DMA1_Stream5;
+	hdma_usart2_rx.Init.Channel = DMA_CHANNEL_4;
+	hdma_usart2_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+	hdma_usart2_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+	hdma_usart2_rx.Init.MemInc = DMA_MINC_ENABLE;
+	hdma_usart2_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdma_usart2_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	hdma_usart2_rx.Init.Mode = DMA_CIRCULAR;
+	hdma_usart2_rx.Init.Priority = DMA_PRIORITY_HIGH;
+	hdma_usart2_rx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+	if (HAL_DMA_Init(&hdma_usart2_rx) != HAL_OK)
+	{
+		return false;
+	}
+	__HAL_LINKDMA(&huart2, hdmarx, hdma_usart2_rx);
+
+	hdma_usart2_tx.Instance = DMA1_Stream6;
+	hdma_usart2_tx.Init.Channel = DMA_CHANNEL_4;
+	hdma_usart2_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+	hdma_usart2_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+	hdma_usart2_tx.Init.MemInc = DMA_MINC_ENABLE;
+	hdma_usart2_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdma_usart2_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	hdma_usart2_tx.Init.Mode = DMA_NORMAL;
+	hdma_usart2_tx.Init.Priority = DMA_PRIORITY_LOW;
+	hdma_usart2_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+	if (HAL_DMA_Init(&hdma_usart2_tx) != HAL_OK)
+	{
+		return false;
+	}
+	__HAL_LINKDMA(&huart2, hdmatx, hdma_usart2_tx);
+
+	HAL_NVIC_SetPriority(DMA1_Stream5_IRQn, 0, 0);
+	HAL_NVIC_EnableIRQ(DMA1_Stream5_IRQn);
+	HAL_NVIC_SetPriority(DMA1_Stream6_IRQn, 0, 0);
+	HAL_NVIC_EnableIRQ(DMA1_Stream6_IRQn);
+	HAL_NVIC_SetPriority(USART2_IRQn, 0, 0);
+	HAL_NVIC_EnableIRQ(USART2_IRQn);
+
+	return true;
+}
+
+/*
+ * Copia el mensaje al buffer circular y retorna; el DMA lo transmite en segundo plano.
+ * Si el mensaje no entra completo se descarta entero y se contabiliza en tx_stats.
+ */
 void uartSendString(uint8_t * pstring)
 {
     if (!checkPointer(pstring)) return;
@@ -55,14 +143,288 @@ void uartSendString(uint8_t * pstring)
 
     if (!checkSize(length)) return;
 
-    HAL_UART_Transmit(&huart2, pstring, length, UART_TIMEOUT);
+    uartTxEnqueue(pstring, length);
 }
 
 void uartSendStringSize(uint8_t * pstring, uint16_t size)
 {
     if (!checkPointer(pstring) || !checkSize(size)) return;
 
-    HAL_UART_Transmit(&huart2, pstring, size, UART_TIMEOUT);
+    uartTxEnqueue(pstring, size);
+}
+
+/*
+ * Espera a que se transmita todo el contenido del buffer. Si se llama desde una interrupción
+ * o con las interrupciones deshabilitadas (por ejemplo desde Error_Handler), atiende los
+ * handlers de DMA y USART por polling para poder terminar igual.
+ */
+void uartFlush(void)
+{
+	while (tx_active)
+	{
+		if (__get_IPSR() != 0 || __get_PRIMASK() != 0)
+		{
+			HAL_DMA_IRQHandler(&hdma_usart2_tx);
+			HAL_UART_IRQHandler(&huart2);
+		}
+	}
+}
+
+/*
+ * Saca de la cola el frame más antiguo recibido. No bloquea.
+ * Retorna la cantidad de bytes copiados en pframe (0 si no hay frames); un frame mayor que
+ * size se trunca.
+ */
+uint16_t uartReceiveFrame(uint8_t * pframe, uint16_t size)
+{
+	if (!checkPointer(pframe) || size == 0 || rx_count == 0) return 0;
+
+	uint16_t length = rx_frame_len[rx_head];
+	if (length > size) length = size;
+	memcpy(pframe, rx_frames[rx_head], length);
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	if (rx_count == UART_RX_FRAME_COUNT) rx_frame_len[rx_head] = 0;   // pasa a ser el slot en armado
+	rx_head = (rx_head + 1) % UART_RX_FRAME_COUNT;
+	rx_count--;
+	__set_PRIMASK(primask);
+
+	return length;
+}
+
+/*
+ * Espera el próximo frame y lo copia como cadena terminada en '\0' (a lo sumo size - 1 caracteres).
+ */
+void uartReceiveStringSize(uint8_t * pstring, uint16_t size)
+{
+	if (!checkPointer(pstring) || !checkSize(size)) return;
+
+	uint16_t length;
+	while ((length = uartReceiveFrame(pstring, size - 1)) == 0) {
+	}
+	pstring[length] = '\0';
+}
+
+void uartGetRxStats(uartRxStats_t *stats)
+{
+	if (stats == NULL) return;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	*stats = rx_stats;
+	__set_PRIMASK(primask);
+}
+
+void uartGetTxStats(uartTxStats_t *stats)
+{
+	if (stats == NULL) return;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	*stats = tx_stats;
+	__set_PRIMASK(primask);
+}
+
+static void uartTxEnqueue(const uint8_t *data, uint16_t size)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	if (size > UART_TX_BUFFER_SIZE - tx_used)
+	{
+		tx_stats.dropped_messages++;
+		tx_stats.dropped_bytes += size;
+		__set_PRIMASK(primask);
+		return;
+	}
+
+	uint16_t first = UART_TX_BUFFER_SIZE - tx_head;
+	if (first > size) first = size;
+	memcpy(&tx_buffer[tx_head], data, first);
+	memcpy(&tx_buffer[0], data + first, size - first);
+
+	tx_head = (tx_head + size) % UART_TX_BUFFER_SIZE;
+	tx_used += size;
+	if (tx_used > tx_stats.high_water) tx_stats.high_water = tx_used;
+
+	if (!tx_active)
+	{
+		tx_active = true;
+		uartTxStartNext();
+	}
+
+	__set_PRIMASK(primask);
+}
+
+/*
+ * Lanza el DMA sobre el tramo contiguo que empieza en tx_tail (hasta tx_head o el fin del buffer).
+ * Se llama con las interrupciones deshabilitadas o desde el callback de fin de transmisión.
+ */
+static void uartTxStartNext(void)
+{
+	uint16_t pending = tx_used - tx_inflight;
+
+	if (pending == 0)
+	{
+		tx_active = false;
+		return;
+	}
+
+	uint16_t start = (tx_tail + tx_inflight) % UART_TX_BUFFER_SIZE;
+	uint16_t chunk = UART_TX_BUFFER_SIZE - start;
+	if (chunk > pending) chunk = pending;
+
+	if (HAL_UART_Transmit_DMA(&huart2, &tx_buffer[start], chunk) != HAL_OK)
+	{
+		// Se descarta lo pendiente para no bloquear a los productores
+		tx_stats.dropped_bytes += pending;
+		tx_used -= pending;
+		tx_head = start;
+		tx_active = (tx_inflight > 0);
+		return;
+	}
+	tx_inflight = chunk;
+}
+
+/*
+ * Libera bytes ya leídos por el DMA, desde el inicio del tramo en vuelo.
+ */
+static void uartTxRelease(uint16_t size)
+{
+	if (size > tx_inflight) size = tx_inflight;
+	tx_tail = (tx_tail + size) % UART_TX_BUFFER_SIZE;
+	tx_used -= size;
+	tx_inflight -= size;
+}
+
+static bool_t uartRxStart(void)
+{
+	rx_last_pos = 0;
+	if (HAL_UARTEx_ReceiveToIdle_DMA(&huart2, rx_dma, UART_RX_DMA_SIZE) != HAL_OK) return false;
+	return true;
+}
+
+/*
+ * Copia los bytes escritos por el DMA desde rx_last_pos hasta pos, contemplando la vuelta del buffer.
+ */
+static void uartRxConsume(uint16_t pos)
+{
+	pos %= UART_RX_DMA_SIZE;
+
+	while (rx_last_pos != pos)
+	{
+		uint16_t end = (pos > rx_last_pos) ? pos : UART_RX_DMA_SIZE;
+		uartRxAppend(&rx_dma[rx_last_pos], end - rx_last_pos);
+		rx_last_pos = end % UART_RX_DMA_SIZE;
+	}
+}
+
+static void uartRxAppend(const uint8_t *data, uint16_t size)
+{
+	// Cola llena, o resto de un frame que ya empezó a descartarse
+	if (rx_count >= UART_RX_FRAME_COUNT || rx_discarded > 0)
+	{
+		rx_discarded += size;
+		return;
+	}
+
+	uint8_t slot = (rx_head + rx_count) % UART_RX_FRAME_COUNT;
+	uint16_t room = UART_RX_FRAME_SIZE - rx_frame_len[slot];
+	if (size > room)
+	{
+		size = room;
+		rx_truncated = true;
+	}
+	memcpy(&rx_frames[slot][rx_frame_len[slot]], data, size);
+	rx_frame_len[slot] += size;
+}
+
+static void uartRxEndFrame(void)
+{
+	if (rx_discarded > 0)
+	{
+		rx_stats.dropped_frames++;
+		rx_discarded = 0;
+	}
+	if (rx_count >= UART_RX_FRAME_COUNT) return;
+
+	uint8_t slot = (rx_head + rx_count) % UART_RX_FRAME_COUNT;
+	if (rx_frame_len[slot] == 0) return;
+
+	if (rx_truncated) rx_stats.truncated_frames++;
+	rx_truncated = false;
+	rx_stats.frames++;
+	rx_count++;
+	if (rx_count < UART_RX_FRAME_COUNT) rx_frame_len[(rx_head + rx_count) % UART_RX_FRAME_COUNT] = 0;
+}
+
+void uartIRQHandler(void)
+{
+	HAL_UART_IRQHandler(&huart2);
+}
+
+void uartDmaTxIRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&hdma_usart2_tx);
+}
+
+void uartDmaRxIRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&hdma_usart2_rx);
+}
+
+/*
+ * Evento de recepción: mitad o fin del buffer circular (solo se copian los bytes) o línea
+ * inactiva, que además cierra el frame. Size es la posición de escritura del DMA en rx_dma.
+ */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+	if (huart != &huart2) return;
+
+	uartRxConsume(Size);
+	if (HAL_UARTEx_GetRxEventType(huart) == HAL_UART_RXEVENT_IDLE) uartRxEndFrame();
+}
+
+/*
+ * A mitad del tramo el DMA ya leyó la primera mitad: se libera para que los productores
+ * tengan espacio antes de que termine la transferencia.
+ */
+void HAL_UART_TxHalfCpltCallback(UART_HandleTypeDef *huart)
+{
+	if (huart != &huart2) return;
+
+	uartTxRelease(huart->TxXferSize / 2);
+}
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+	if (huart != &huart2) return;
+
+	uartTxRelease(tx_inflight);
+	uartTxStartNext();
+}
+
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+	if (huart != &huart2) return;
+
+	if (huart->gState == HAL_UART_STATE_READY && tx_inflight > 0)
+	{
+		tx_stats.dropped_bytes += tx_inflight;
+		uartTxRelease(tx_inflight);
+		uartTxStartNext();
+	}
+
+	// Un error de línea con DMA de recepción activo aborta la recepción: se descarta el frame en armado y se reinicia
+	if (huart->RxState == HAL_UART_STATE_READY)
+	{
+		rx_stats.errors++;
+		if (rx_count < UART_RX_FRAME_COUNT) rx_frame_len[(rx_head + rx_count) % UART_RX_FRAME_COUNT] = 0;
+		rx_truncated = false;
+		rx_discarded = 0;
+		uartRxStart();
+	}
 }
 
 
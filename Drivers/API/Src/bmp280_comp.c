@@ -0,0 +1,260 @@
+/*
+ * bmp280_comp.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ */
+
+#include "bmp280_comp.h"
+#if BMP280_COMP_BENCHMARK
+#include "API_delay.h"
+
+#define BMP280_COMP_BENCH_RUNS  16
+#endif
+
+/**
+ * @brief Carga los parámetros de calibración y precalcula los coeficientes de cada back-end.
+ *
+ * @param c     Coeficientes de salida.
+ * @param calib Los 24 bytes leídos desde `0x88` (little-endian).
+ *
+ * @details
+ * 1. Se decodifican `dig_T1..dig_T3` y `dig_P1..dig_P9` como en el datasheet.
+ * 2. Back-end de 32 bits: se guardan ya desplazados los términos constantes de las fórmulas de Bosch.
+ * 3. Back-end `float`: cada división por una potencia de 2 de la fórmula de referencia se pliega
+ *    en el coeficiente correspondiente, de modo que en tiempo de ejecución solo quedan
+ *    multiplicaciones/sumas y una única división en la presión.
+ *
+ * @note
+ * - Se llama una vez, tras leer la calibración; no depende de la HAL y compila también en el host.
+ */
+
+void BMP280_CompInit(BMP280_CompCoeffs *c, const uint8_t *calib)
+{
+	c->dig_T1 = (uint16_t)(calib[1] << 8 | calib[0]);
+	c->dig_T2 = (int16_t)(calib[3] << 8 | calib[2]);
+	c->dig_T3 = (int16_t)(calib[5] << 8 | calib[4]);
+
+	c->dig_P1 = (uint16_t)(calib[7] << 8 | calib[6]);
+	c->dig_P2 = (int16_t)(calib[9] << 8 | calib[8]);
+	c->dig_P3 = (int16_t)(calib[11] << 8 | calib[10]);
+	c->dig_P4 = (int16_t)(calib[13] << 8 | calib[12]);
+	c->dig_P5 = (int16_t)(calib[15] << 8 | calib[14]);
+	c->dig_P6 = (int16_t)(calib[17] << 8 | calib[16]);
+	c->dig_P7 = (int16_t)(calib[19] << 8 | calib[18]);
+	c->dig_P8 = (int16_t)(calib[21] << 8 | calib[20]);
+	c->dig_P9 = (int16_t)(calib[23] << 8 | calib[22]);
+
+	c->t1_x2 = (int32_t)c->dig_T1 << 1;
+	c->p4_s16 = (int32_t)c->dig_P4 * 65536;
+	c->p5_x2 = (int32_t)c->dig_P5 * 2;
+
+	c->ft1_1024 = c->dig_T1 / 1024.0f;
+	c->ft1_8192 = c->dig_T1 / 8192.0f;
+	c->ft2 = c->dig_T2;
+	c->ft3 = c->dig_T3;
+
+	c->fp1 = c->dig_P1;
+	c->fp1_32768 = c->dig_P1 / 32768.0f;
+	c->fp2 = c->dig_P2 / 524288.0f;
+	c->fp3 = c->dig_P3 / 274877906944.0f;   // 2^38
+	c->fp4 = c->dig_P4 * 65536.0f;
+	c->fp5 = c->dig_P5 * 2.0f;
+	c->fp6 = c->dig_P6 / 32768.0f;
+	c->fp7_16 = c->dig_P7 / 16.0f;
+	c->fp8 = c->dig_P8 / 32768.0f;
+	c->fp9 = c->dig_P9 / 2147483648.0f;     // 2^31
+}
+
+/**
+ * @brief Compensación de temperatura en entero de 32 bits (fórmula de Bosch).
+ *
+ * @param c      Coeficientes precalculados.
+ * @param adc_T  Valor ADC de temperatura de 20 bits.
+ * @param t_fine Salida: temperatura fina, requerida por la presión de la misma conversión.
+ *
+ * @return Temperatura en centésimas de °C (por ejemplo `2534` = 25.34 °C).
+ */
+
+int32_t BMP280_CompTemperatureInt32(const BMP280_CompCoeffs *c, int32_t adc_T, int32_t *t_fine)
+{
+	int32_t var1 = (((adc_T >> 3) - c->t1_x2) * c->dig_T2) >> 11;
+	int32_t d = (adc_T >> 4) - (int32_t)c->dig_T1;
+	int32_t var2 = (((d * d) >> 12) * c->dig_T3) >> 14;
+
+	*t_fine = var1 + var2;
+	return (*t_fine * 5 + 128) >> 8;
+}
+
+/**
+ * @brief Compensación de temperatura en punto flotante simple.
+ *
+ * @param c      Coeficientes precalculados.
+ * @param adc_T  Valor ADC de temperatura de 20 bits.
+ * @param t_fine Salida: temperatura fina (misma escala que la versión entera).
+ *
+ * @return Temperatura en °C.
+ */
+
+float BMP280_CompTemperatureFloat(const BMP280_CompCoeffs *c, int32_t adc_T, float *t_fine)
+{
+	float adc = (float)adc_T;
+	float var1 = (adc * (1.0f / 16384.0f) - c->ft1_1024) * c->ft2;
+	float d = adc * (1.0f / 131072.0f) - c->ft1_8192;
+	float var2 = d * d * c->ft3;
+
+	*t_fine = var1 + var2;
+	return *t_fine * (1.0f / 5120.0f);
+}
+
+/**
+ * @brief Compensación de presión de referencia con enteros de 64 bits (fórmula de Bosch).
+ *
+ * @return Presión en Pa en formato Q24.8 (dividir por 256), o 0 si la calibración es inválida.
+ *
+ * @note
+ * - Es la versión más precisa, pero la división de 64 bits se resuelve por software
+ *   (`__aeabi_ldivmod`) y es la más lenta en Cortex-M4. Se conserva como referencia.
+ */
+
+uint32_t BMP280_CompPressureInt64(const BMP280_CompCoeffs *c, int32_t adc_P, int32_t t_fine)
+{
+	int64_t var1 = ((int64_t)t_fine) - 128000;
+	int64_t var2 = var1 * var1 * (int64_t)c->dig_P6;
+	var2 = var2 + ((var1 * (int64_t)c->dig_P5) << 17);
+	var2 = var2 + (((int64_t)c->dig_P4) << 35);
+	var1 = ((var1 * var1 * (int64_t)c->dig_P3) >> 8) + ((var1 * (int64_t)c->dig_P2) << 12);
+	var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)c->dig_P1) >> 33;
+
+	if (var1 == 0) return 0; // Evitar división por cero
+
+	int64_t p = 1048576 - adc_P;
+	p = (((p << 31) - var2) * 3125) / var1;
+	var1 = (((int64_t)c->dig_P9) * (p >> 13) * (p >> 13)) >> 25;
+	var2 = (((int64_t)c->dig_P8) * p) >> 19;
+
+	p = ((p + var1 + var2) >> 8) + (((int64_t)c->dig_P7) << 4);
+	return (uint32_t)p;
+}
+
+/**
+ * @brief Compensación de presión solo con enteros de 32 bits (fórmula alternativa de Bosch).
+ *
+ * @return Presión en Pa (resolución de 1 Pa ≈ 8 cm de altitud), o 0 si la calibración es inválida.
+ *
+ * @details
+ * Usa únicamente multiplicaciones, desplazamientos y una división de 32 bits (`UDIV` en hardware).
+ *
+ * @note
+ * - Frente a la referencia de 64 bits el error máximo es 6.9 Pa (medio 1.2 Pa) en todo el rango
+ *   de operación, con la calibración del datasheet (`Tools/bmp280_comp_check`).
+ */
+
+uint32_t BMP280_CompPressureInt32(const BMP280_CompCoeffs *c, int32_t adc_P, int32_t t_fine)
+{
+	int32_t var1 = (t_fine >> 1) - 64000;
+	int32_t var2 = (((var1 >> 2) * (var1 >> 2)) >> 11) * c->dig_P6;
+	var2 = var2 + var1 * c->p5_x2;
+	var2 = (var2 >> 2) + c->p4_s16;
+	var1 = (((c->dig_P3 * (((var1 >> 2) * (var1 >> 2)) >> 13)) >> 3) + ((c->dig_P2 * var1) >> 1)) >> 18;
+	var1 = ((32768 + var1) * (int32_t)c->dig_P1) >> 15;
+
+	if (var1 == 0) return 0; // Evitar división por cero
+
+	uint32_t p = ((uint32_t)(1048576 - adc_P) - (uint32_t)(var2 >> 12)) * 3125;
+	if (p < 0x80000000U) {
+		p = (p << 1) / (uint32_t)var1;
+	} else {
+		p = (p / (uint32_t)var1) * 2;
+	}
+
+	var1 = (c->dig_P9 * (int32_t)(((p >> 3) * (p >> 3)) >> 13)) >> 12;
+	var2 = ((int32_t)(p >> 2) * c->dig_P8) >> 13;
+	return (uint32_t)((int32_t)p + ((var1 + var2 + c->dig_P7) >> 4));
+}
+
+/**
+ * @brief Compensación de presión en punto flotante simple (FPU).
+ *
+ * @return Presión en Pa, o 0 si la calibración es inválida.
+ *
+ * @details
+ * Es la fórmula en `double` del datasheet con las potencias de 2 plegadas en los coeficientes
+ * (`BMP280_CompInit()`): una división y ~15 operaciones `VMUL`/`VADD`/`VFMA`.
+ *
+ * @note
+ * - Frente a la referencia de 64 bits el error máximo es 0.094 Pa (medio 0.023 Pa) en todo el rango
+ *   de operación, con la calibración del datasheet (`Tools/bmp280_comp_check`).
+ */
+
+float BMP280_CompPressureFloat(const BMP280_CompCoeffs *c, int32_t adc_P, float t_fine)
+{
+	float var1 = t_fine * 0.5f - 64000.0f;
+	float var2 = var1 * var1 * c->fp6 + var1 * c->fp5;
+	var2 = var2 * 0.25f + c->fp4;
+	var1 = (c->fp3 * var1 + c->fp2) * var1;
+	var1 = c->fp1 + var1 * c->fp1_32768;
+
+	if (var1 == 0.0f) return 0; // Evitar división por cero
+
+	float p = 1048576.0f - (float)adc_P;
+	p = (p - var2 * (1.0f / 4096.0f)) * 6250.0f / var1;
+	var1 = c->fp9 * p * p;
+	var2 = p * c->fp8;
+	return p + (var1 + var2) * (1.0f / 16.0f) + c->fp7_16;
+}
+
+#if BMP280_COMP_BENCHMARK
+/*
+ * Mide con el contador DWT (requiere delayUsInit()) el costo de cada back-end con la calibración
+ * y la muestra de ejemplo del datasheet (adc_T = 519888, adc_P = 415148). Se toma el mínimo de
+ * BMP280_COMP_BENCH_RUNS corridas para no contar interrupciones.
+ */
+void BMP280_CompMeasureCycles(BMP280_CompBenchmark *result)
+{
+	static const uint8_t calib[BMP280_CALIB_LENGTH] = {
+		0x70, 0x6B, 0x43, 0x67, 0x18, 0xFC, 0x7D, 0x8E, 0x43, 0xD6, 0xD0, 0x0B,
+		0x27, 0x0B, 0x8C, 0x00, 0xF9, 0xFF, 0x8C, 0x3C, 0xF8, 0xC6, 0x70, 0x17
+	};
+	const int32_t adc_T = 519888, adc_P = 415148;
+	volatile uint32_t sink_u;
+	volatile float sink_f;
+	BMP280_CompCoeffs c;
+	int32_t t_fine;
+	float t_fine_f;
+
+	BMP280_CompInit(&c, calib);
+	result->temp_int32 = result->temp_float = UINT32_MAX;
+	result->press_int64 = result->press_int32 = result->press_float = UINT32_MAX;
+
+	for (uint32_t run = 0; run < BMP280_COMP_BENCH_RUNS; run++)
+	{
+		uint32_t start = delayGetCycles();
+		sink_u = (uint32_t)BMP280_CompTemperatureInt32(&c, adc_T, &t_fine);
+		uint32_t cycles = delayGetCycles() - start;
+		if (cycles < result->temp_int32) result->temp_int32 = cycles;
+
+		start = delayGetCycles();
+		sink_f = BMP280_CompTemperatureFloat(&c, adc_T, &t_fine_f);
+		cycles = delayGetCycles() - start;
+		if (cycles < result->temp_float) result->temp_float = cycles;
+
+		start = delayGetCycles();
+		sink_u = BMP280_CompPressureInt64(&c, adc_P, t_fine);
+		cycles = delayGetCycles() - start;
+		if (cycles < result->press_int64) result->press_int64 = cycles;
+
+		start = delayGetCycles();
+		sink_u = BMP280_CompPressureInt32(&c, adc_P, t_fine);
+		cycles = delayGetCycles() - start;
+		if (cycles < result->press_int32) result->press_int32 = cycles;
+
+		start = delayGetCycles();
+		sink_f = BMP280_CompPressureFloat(&c, adc_P, t_fine_f);
+		cycles = delayGetCycles() - start;
+		if (cycles < result->press_float) result->press_float = cycles;
+	}
+	(void)sink_u;
+	(void)sink_f;
+}
+#endif
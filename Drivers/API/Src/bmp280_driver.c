@@ -7,17 +7,41 @@
 
 #include "bmp280_driver.h"
 #include "bmp280_port.h"
-#include "API_uart.h"
-#include "math.h"
-
-static uint16_t dig_T1, dig_P1;
-static int16_t dig_T2, dig_T3;
-static int16_t dig_P2, dig_P3, dig_P4, dig_P5, dig_P6, dig_P7, dig_P8, dig_P9;
-static int32_t t_fine;
-
-static uint8_t BMP280_ReadRegister(uint8_t reg);
-static void BMP280_WriteRegister(uint8_t reg, uint8_t value);
-static void BMP280_ReadCalibrationData(void);
+#include "bmp280_comp.h"
+#include "API_log.h"
+#include "API_delay.h"
+#include "API_altitude.h"
+
+// Sensor por defecto de la API de un solo sensor (CS en BMP280_CS_PIN)
+static bmp280_dev_t bmp280_default;
+
+// Secuenciador de bus: sensores encadenados y posición del que está en transferencia
+static bmp280_dev_t *seq_devs[BMP280_SEQ_MAX_DEVICES];
+static uint8_t seq_count;
+static volatile uint8_t seq_index;
+static volatile BMP280_AcqState seq_state = BMP280_ACQ_IDLE;
+
+// Perfiles de consumo/desempeño y configuración activa
+static const BMP280_Settings profiles[BMP280_PROFILE_COUNT] = {
+    [BMP280_PROFILE_ULTRA_LOW_POWER]    = { BMP280_OSRS_X1, BMP280_OSRS_X1,  BMP280_FILTER_OFF, BMP280_STANDBY_4000MS, BMP280_OPMODE_NORMAL },
+    [BMP280_PROFILE_STANDARD]           = { BMP280_OSRS_X1, BMP280_OSRS_X4,  BMP280_FILTER_4,   BMP280_STANDBY_125MS,  BMP280_OPMODE_NORMAL },
+    [BMP280_PROFILE_HIGH_RESOLUTION]    = { BMP280_OSRS_X2, BMP280_OSRS_X16, BMP280_FILTER_4,   BMP280_STANDBY_62_5MS, BMP280_OPMODE_NORMAL },
+    [BMP280_PROFILE_INDOOR_NAVIGATION]  = { BMP280_OSRS_X2, BMP280_OSRS_X16, BMP280_FILTER_16,  BMP280_STANDBY_0_5MS,  BMP280_OPMODE_NORMAL },
+    [BMP280_PROFILE_HIGH_RATE]          = { BMP280_OSRS_X1, BMP280_OSRS_X2,  BMP280_FILTER_OFF, BMP280_STANDBY_0_5MS,  BMP280_OPMODE_NORMAL },
+    [BMP280_PROFILE_WEATHER_MONITORING] = { BMP280_OSRS_X1, BMP280_OSRS_X1,  BMP280_FILTER_OFF, BMP280_STANDBY_0_5MS,  BMP280_OPMODE_FORCED },
+};
+static const uint32_t standby_us[] = { 500, 62500, 125000, 250000, 500000, 1000000, 2000000, 4000000 };
+
+static uint8_t BMP280_ReadRegister(bmp280_dev_t *dev, uint8_t reg);
+static void BMP280_WriteRegister(bmp280_dev_t *dev, uint8_t reg, uint8_t value);
+static void BMP280_ReadCalibrationData(bmp280_dev_t *dev);
+static float BMP280_CompensateTemperature(bmp280_dev_t *dev, int32_t adc_T);
+static float BMP280_CompensatePressure(bmp280_dev_t *dev, int32_t adc_P);
+static void BMP280_AcquisitionComplete(HAL_StatusTypeDef status, void *context);
+static void BMP280_SeqStep(HAL_StatusTypeDef status, void *context);
+static void BMP280_ConvertBurst(bmp280_dev_t *dev, const uint8_t *raw_data, BMP280_Measurement *data);
+static void BMP280_WaitIdle(const bmp280_dev_t *dev);
+static uint32_t BMP280_OversamplingCount(BMP280_Oversampling osrs);
 
 /**
  * @brief Lee y almacena los datos de calibración interna del sensor BMP280.
@@ -29,41 +53,24 @@ static void BMP280_ReadCalibrationData(void);
  *
  * @details
  * 1. Se realiza una lectura secuencial de 24 bytes desde la dirección base `BMP280_REG_CALIB_START` (0x88).
- * 2. Se utiliza el protocolo SPI, activando el chip con `BMP280_SPI_CS_Select()` y desactivándolo al final.
- * 3. Los datos se interpretan en formato little-endian y se copian a las variables globales:
- *    - `dig_T1` a `dig_T3` → coeficientes de calibración de temperatura
- *    - `dig_P1` a `dig_P9` → coeficientes de calibración de presión
+ * 2. Se utiliza `BMP280_PortSPI_Read()`, que activa el CS del sensor, envía la dirección con el bit de
+ *    lectura y lo desactiva al final.
+ * 3. Los datos se entregan a `BMP280_CompInit()`, que decodifica `dig_T1..dig_T3` y `dig_P1..dig_P9`
+ *    y precalcula en `dev->comp` los coeficientes del back-end de compensación (`BMP280_COMP_BACKEND`).
  *
  * @note
  * - Esta función debe ser llamada solo una vez tras el arranque del sensor.
  * - Es fundamental para el uso de las funciones de compensación de temperatura y presión.
- * - Asegurate de que las funciones `BMP280_PortSPI_WriteRegister` y `BMP280_PortSPI_ReadRegister`
- *   estén correctamente implementadas según el microcontrolador y la biblioteca HAL.
+ * - Asegurate de que las funciones `BMP280_PortSPI_Read` y `BMP280_PortSPI_Write` estén
+ *   correctamente implementadas según el microcontrolador (back-end HAL o LL, `BMP280_PORT_BACKEND`).
  *
  */
 
-static void BMP280_ReadCalibrationData(void) {
-    uint8_t calib_data[24];
-    uint8_t reg = BMP280_REG_CALIB_START;
-    BMP280_SPI_CS_Select();
-    reg |= 0x80; // lectura
-    BMP280_PortSPI_WriteRegister(&reg, 1);
-    BMP280_PortSPI_ReadRegister(calib_data, 24);
-    BMP280_SPI_CS_Deselect();
-
-    dig_T1 = (uint16_t)(calib_data[1] << 8 | calib_data[0]);
-    dig_T2 = (int16_t)(calib_data[3] << 8 | calib_data[2]);
-    dig_T3 = (int16_t)(calib_data[5] << 8 | calib_data[4]);
+static void BMP280_ReadCalibrationData(bmp280_dev_t *dev) {
+    uint8_t calib_data[BMP280_CALIB_LENGTH];
+    BMP280_PortSPI_Read(&dev->spi, BMP280_REG_CALIB_START, calib_data, BMP280_CALIB_LENGTH);
 
-    dig_P1 = (uint16_t)(calib_data[7] << 8 | calib_data[6]);
-    dig_P2 = (int16_t)(calib_data[9] << 8 | calib_data[8]);
-    dig_P3 = (int16_t)(calib_data[11] << 8 | calib_data[10]);
-    dig_P4 = (int16_t)(calib_data[13] << 8 | calib_data[12]);
-    dig_P5 = (int16_t)(calib_data[15] << 8 | calib_data[14]);
-    dig_P6 = (int16_t)(calib_data[17] << 8 | calib_data[16]);
-    dig_P7 = (int16_t)(calib_data[19] << 8 | calib_data[18]);
-    dig_P8 = (int16_t)(calib_data[21] << 8 | calib_data[20]);
-    dig_P9 = (int16_t)(calib_data[23] << 8 | calib_data[22]);
+    BMP280_CompInit(&dev->comp, calib_data);
 }
 
 /**
@@ -72,6 +79,7 @@ static void BMP280_ReadCalibrationData(void) {
  * Esta función realiza una lectura SPI de 8 bits desde el registro especificado del BMP280.
  * Se usa para acceder a configuraciones, resultados de conversión o cualquier registro del sensor.
  *
+ * @param dev Sensor a leer.
  * @param reg Dirección del registro a leer (por ejemplo, `BMP280_REG_ID` o `BMP280_REG_TEMP_MSB`).
  *            La función se encarga de establecer el bit de lectura (MSB = 1).
  *
@@ -80,9 +88,11 @@ static void BMP280_ReadCalibrationData(void) {
  * @details
  * 1. El bit MSB del registro (`reg | 0x80`) se activa para indicar una operación de lectura según
  *    el protocolo SPI del BMP280.
- * 2. Se selecciona el dispositivo activando su línea CS (`BMP280_SPI_CS_Select`).
+ * 2. Se selecciona el dispositivo activando su línea CS.
  * 3. Se escribe la dirección del registro y luego se realiza la lectura de un byte.
- * 4. Finalmente, se desactiva la línea CS (`BMP280_SPI_CS_Deselect`) y se devuelve el valor leído.
+ * 4. Finalmente, se desactiva la línea CS y se devuelve el valor leído.
+ *
+ * Los cuatro pasos los realiza `BMP280_PortSPI_Read()` en una sola llamada.
  *
  * @note
  * - Esta función es útil para tareas de diagnóstico, lectura de ID del dispositivo, estado o configuración.
@@ -90,12 +100,9 @@ static void BMP280_ReadCalibrationData(void) {
  *
  */
 
-static uint8_t BMP280_ReadRegister(uint8_t reg) {
-    uint8_t rx, tx = reg | 0x80; // Set MSB for read
-    BMP280_SPI_CS_Select();
-    BMP280_PortSPI_WriteRegister(&tx, 1);
-    BMP280_PortSPI_ReadRegister(&rx, 1);
-    BMP280_SPI_CS_Deselect();
+static uint8_t BMP280_ReadRegister(bmp280_dev_t *dev, uint8_t reg) {
+    uint8_t rx;
+    BMP280_PortSPI_Read(&dev->spi, reg, &rx, 1);
     return rx;
 }
 
@@ -105,17 +112,15 @@ static uint8_t BMP280_ReadRegister(uint8_t reg) {
  * Esta función permite configurar el sensor BMP280 escribiendo en uno de sus registros de control,
  * configuración o estado. Utiliza el bus SPI para enviar la dirección del registro y el dato.
  *
+ * @param dev   Sensor a escribir.
  * @param reg   Dirección del registro a escribir (por ejemplo, `BMP280_REG_CTRL_MEAS`).
  *              El bit MSB se limpia automáticamente para indicar una operación de escritura.
  * @param value Valor de 8 bits que se desea escribir en el registro.
  *
  * @details
- * 1. Se prepara un arreglo `data[2]` donde:
- *    - `data[0]` contiene la dirección del registro con el bit MSB en 0 (escritura).
- *    - `data[1]` contiene el valor a escribir.
- * 2. Se selecciona el sensor activando el pin CS (`BMP280_SPI_CS_Select`).
- * 3. Se envían ambos bytes mediante `BMP280_PortSPI_WriteRegister`.
- * 4. Se desactiva el pin CS (`BMP280_SPI_CS_Deselect`) para finalizar la transacción SPI.
+ * 1. `BMP280_PortSPI_Write()` selecciona el sensor activando su pin CS.
+ * 2. Envía la dirección del registro con el bit MSB en 0 (escritura) y luego el valor.
+ * 3. Desactiva el pin CS para finalizar la transacción SPI.
  *
  * @note
  * - Es fundamental asegurarse de que el sensor esté en modo de reposo o standby
@@ -123,11 +128,8 @@ static uint8_t BMP280_ReadRegister(uint8_t reg) {
  * - El bit MSB debe estar en 0 para escritura (por eso se enmascara con `0x7F`).
  *
  */
-static void BMP280_WriteRegister(uint8_t reg, uint8_t value) {
-    uint8_t data[2] = {reg & 0x7F, value};
-    BMP280_SPI_CS_Select();
-    BMP280_PortSPI_WriteRegister(data, 2);
-    BMP280_SPI_CS_Deselect();
+static void BMP280_WriteRegister(bmp280_dev_t *dev, uint8_t reg, uint8_t value) {
+    BMP280_PortSPI_Write(&dev->spi, reg, value);
 }
 
 /**
@@ -136,20 +138,21 @@ static void BMP280_WriteRegister(uint8_t reg, uint8_t value) {
  * Esta función es un alias directo de `BMP280_ReadRegister`, usada para mejorar la legibilidad
  * del código cuando se necesita una lectura simple de 1 byte desde el sensor.
  *
+ * @param dev Sensor a leer.
  * @param reg Dirección del registro a leer.
  *
  * @return Valor de 8 bits leído desde el registro.
  *
  * @details
- * Internamente, esta función llama a `BMP280_ReadRegister(reg)`, el cual realiza la transacción
+ * Internamente, esta función llama a `BMP280_ReadRegister(dev, reg)`, el cual realiza la transacción
  * SPI correspondiente. Se utiliza comúnmente en etapas de inicialización o verificación de estado.
  *
  * @note
  * - Para mayor control, se puede utilizar directamente `BMP280_ReadRegister()`.
  *
  */
-uint8_t BMP280_Read8(uint8_t reg) {
-    return BMP280_ReadRegister(reg);
+uint8_t BMP280_DevRead8(bmp280_dev_t *dev, uint8_t reg) {
+    return BMP280_ReadRegister(dev, reg);
 }
 
 /**
@@ -158,64 +161,286 @@ uint8_t BMP280_Read8(uint8_t reg) {
  * Esta función es un alias directo de `BMP280_WriteRegister`, utilizada para mejorar la legibilidad
  * o mantener compatibilidad con estilos de API donde las funciones se nombran como `Write8`.
  *
+ * @param dev   Sensor a escribir.
  * @param reg   Dirección del registro donde se desea escribir.
  * @param value Valor de 8 bits a escribir en el registro.
  *
  * @details
- * Internamente, esta función llama a `BMP280_WriteRegister(reg, value)`, la cual se encarga
+ * Internamente, esta función llama a `BMP280_WriteRegister(dev, reg, value)`, la cual se encarga
  * de enviar el dato al sensor por SPI. Es útil para configurar parámetros del sensor como el modo de operación,
  * oversampling o filtros.
  */
 
-void BMP280_Write8(uint8_t reg, uint8_t value) {
-    BMP280_WriteRegister(reg, value);
+void BMP280_DevWrite8(bmp280_dev_t *dev, uint8_t reg, uint8_t value) {
+    BMP280_WriteRegister(dev, reg, value);
 }
 
 
 /**
- * @brief Inicializa el sensor BMP280 a través de la interfaz SPI.
+ * @brief Inicializa un sensor BMP280 del bus SPI2 y su descriptor.
  *
  * Esta función verifica la identidad del sensor, lo resetea, carga los coeficientes de calibración,
  * y configura los registros de operación con parámetros por defecto.
  *
+ * @param dev     Descriptor del sensor; debe permanecer válido mientras se use (normalmente `static`).
+ * @param cs_port Puerto GPIO del chip select del sensor.
+ * @param cs_pin  Pin del chip select (`GPIO_PIN_x`).
+ *
  * @details
+ * 0. Se inicializa el descriptor (comando de ráfaga `0xF7 | 0x80`, estado `IDLE`) y se declara el sensor
+ *    en el bus con `BMP280_PortSPI_DeviceInit()`: CS como salida en alto y el prescaler más rápido
+ *    que no supere los 10 MHz del BMP280.
  * 1. Espera 100 ms para asegurar que el sensor esté listo tras el encendido.
  * 2. Verifica el ID del sensor (registro `0xD0`) para confirmar que se trata de un BMP280.
  *    Si el valor leído no coincide con `BMP280_CHIP_ID`, se informa por UART y se detiene la ejecución.
  * 3. Se envía un comando de "soft reset" escribiendo `BMP280_RESET_VALUE` en `BMP280_REG_RESET`.
  * 4. Se vuelve a esperar para asegurar la aplicación del reset.
  * 5. Se leen los coeficientes de calibración del sensor con `BMP280_ReadCalibrationData()`.
- * 6. Se configura el registro `CONFIG` con un filtro IIR y tiempo de espera (`tstandby`).
- * 7. Finalmente, se activa el sensor configurando el registro `CTRL_MEAS` con:
- *    - Oversampling x1 para temperatura y presión
- *    - Modo normal de operación (`0x27`)
+ * 6. Se habilita el contador de ciclos para los retardos en µs del modo forzado (`delayUsInit()`).
+ * 7. Se aplica el perfil `BMP280_PROFILE_STANDARD` con `BMP280_SetProfile()`, que configura
+ *    `CONFIG` (filtro IIR y `t_standby`) y `CTRL_MEAS` (oversampling y modo normal).
  *
+ * @note
+ * - Las escrituras usan `BMP280_WriteRegister()`, que controla CS y limpia el bit 7 de la
+ *   dirección (en SPI el bit 7 en 1 indica lectura).
+ * - Con varios sensores en el bus, declarar antes todos los CS con `BMP280_PortSPI_DeviceInit()`:
+ *   un sensor con el CS flotante puede responder en MISO durante la detección de otro.
+ *
+ * @example
+ * ```c
+ * static bmp280_dev_t baro_a, baro_b;
+ * BMP280_DevInit(&baro_a, GPIOA, GPIO_PIN_4);
+ * BMP280_DevInit(&baro_b, GPIOB, GPIO_PIN_12);
+ * ```
  */
 
-void BMP280_Init(void) {
+void BMP280_DevInit(bmp280_dev_t *dev, GPIO_TypeDef *cs_port, uint16_t cs_pin) {
+    dev->acq_tx[0] = BMP280_REG_PRESS_MSB | 0x80;
+    dev->acq_state = BMP280_ACQ_IDLE;
+    dev->forced_pending = false;
+    BMP280_PortSPI_DeviceInit(&dev->spi, cs_port, cs_pin);
+
     HAL_Delay(100);
-    uint8_t id = 0xD0;
-    BMP280_SPI_CS_Select();
-    id |= 0x80;
-    BMP280_PortSPI_WriteRegister(&id, 1);
-    BMP280_PortSPI_ReadRegister(&id, 1);
-    BMP280_SPI_CS_Deselect();
+    uint8_t id = BMP280_ReadRegister(dev, BMP280_REG_ID);
 
     if (id != BMP280_CHIP_ID) {
-        uartSendString((uint8_t*)"BMP280 NOT FOUND\r\n");
+        LOG("BMP280 NOT FOUND (cs=0x%04X id=0x%02X)", cs_pin, id);
         Error_Handler();
     }
 
-    uint8_t reset_cmd[2] = {BMP280_REG_RESET, BMP280_RESET_VALUE};
-    BMP280_PortSPI_WriteRegister(reset_cmd, 2);
+    BMP280_WriteRegister(dev, BMP280_REG_RESET, BMP280_RESET_VALUE);
     HAL_Delay(100);
 
-    BMP280_ReadCalibrationData();
+    BMP280_ReadCalibrationData(dev);
+
+    if (!delayUsInit()) Error_Handler();
+    BMP280_DevSetProfile(dev, BMP280_PROFILE_STANDARD);
+}
+
+/**
+ * @brief Aplica uno de los perfiles de consumo/desempeño predefinidos.
+ *
+ * @param dev     Sensor a configurar.
+ * @param profile Perfil (`BMP280_PROFILE_*`), basado en los casos de uso del datasheet.
+ *
+ * @return `false` si el perfil no existe, `true` en caso contrario.
+ *
+ * @note
+ * - El período entre resultados cambia con el perfil: una tarea que consulta el sensor a
+ *   `BMP280_GetSamplePeriodUs()` debe actualizarse con `schedulerSetPeriod()` (ver `BaroSetProfile()` en main.c).
+ *
+ * @example
+ * ```c
+ * BMP280_SetProfile(BMP280_PROFILE_INDOOR_NAVIGATION);
+ * schedulerAddTask("baro", TaskBaro, NULL, BMP280_GetSamplePeriodUs(), 0);
+ * ```
+ */
+
+bool_t BMP280_DevSetProfile(bmp280_dev_t *dev, BMP280_Profile profile) {
+    if (profile >= BMP280_PROFILE_COUNT) return false;
+    return BMP280_DevConfigure(dev, &profiles[profile]);
+}
+
+/**
+ * @brief Configura oversampling, filtro IIR, tiempo de standby y modo de operación.
+ *
+ * @param dev      Sensor a configurar.
+ * @param settings Configuración deseada.
+ *
+ * @return `false` si algún campo está fuera de rango (no se escribe nada), `true` en caso contrario.
+ *
+ * @details
+ * 1. Se espera a que termine la adquisición DMA en curso (propia o del secuenciador de bus).
+ * 2. Se pasa a modo sleep: en modo normal el sensor puede ignorar las escrituras a `CONFIG`.
+ * 3. Se escribe `CONFIG` (`t_sb`, `filter`) y luego `CTRL_MEAS` (`osrs_t`, `osrs_p` y modo). En modo
+ *    forzado el sensor queda en sleep hasta cada `BMP280_TriggerConversion()`.
+ * 4. Se calcula el tiempo máximo de medición:
+ *    ```
+ *    t_meas = 1250 + 2300 · osrs_t + (2300 · osrs_p + 575)  [µs]
+ *    ```
+ *    donde `osrs_*` es la cantidad de muestras (0 si se omite la medición).
+ *
+ * @note
+ * - Con el filtro IIR activo, cada salida mezcla varias conversiones: el tiempo de respuesta a
+ *   un escalón es de varios períodos (por ejemplo ~22 muestras al 75 % con coeficiente 16).
+ */
+
+bool_t BMP280_DevConfigure(bmp280_dev_t *dev, const BMP280_Settings *settings) {
+    if (settings == NULL || settings->osrs_t > BMP280_OSRS_X16 || settings->osrs_p > BMP280_OSRS_X16 ||
+        settings->filter > BMP280_FILTER_16 || settings->standby > BMP280_STANDBY_4000MS ||
+        settings->mode > BMP280_OPMODE_FORCED) return false;
+
+    BMP280_WaitIdle(dev);
+
+    BMP280_WriteRegister(dev, BMP280_REG_CTRL_MEAS, BMP280_MODE_SLEEP);
+    BMP280_WriteRegister(dev, BMP280_REG_CONFIG, (uint8_t)((settings->standby << BMP280_T_SB_POS) |
+                                                           (settings->filter << BMP280_FILTER_POS)));
+    dev->ctrl_meas_osrs = (uint8_t)((settings->osrs_t << BMP280_OSRS_T_POS) | (settings->osrs_p << BMP280_OSRS_P_POS));
+    BMP280_WriteRegister(dev, BMP280_REG_CTRL_MEAS, dev->ctrl_meas_osrs |
+                         ((settings->mode == BMP280_OPMODE_NORMAL) ? BMP280_MODE_NORMAL : BMP280_MODE_SLEEP));
+
+    dev->settings = *settings;
+    dev->forced_pending = false;
+    dev->meas_time_us = BMP280_TMEAS_BASE_US + BMP280_TMEAS_STEP_US * BMP280_OversamplingCount(settings->osrs_t);
+    dev->meas_time_typ_us = BMP280_TMEAS_TYP_BASE_US + BMP280_TMEAS_TYP_STEP_US * BMP280_OversamplingCount(settings->osrs_t);
+    if (settings->osrs_p != BMP280_OSRS_SKIP) {
+        dev->meas_time_us += BMP280_TMEAS_STEP_US * BMP280_OversamplingCount(settings->osrs_p) + BMP280_TMEAS_PRESS_US;
+        dev->meas_time_typ_us += BMP280_TMEAS_TYP_STEP_US * BMP280_OversamplingCount(settings->osrs_p) + BMP280_TMEAS_TYP_PRESS_US;
+    }
+    return true;
+}
+
+/**
+ * @brief Devuelve la configuración activa.
+ */
+
+void BMP280_DevGetSettings(const bmp280_dev_t *dev, BMP280_Settings *settings) {
+    if (settings != NULL) *settings = dev->settings;
+}
+
+/**
+ * @brief Devuelve el tiempo máximo de una conversión con la configuración activa, en µs.
+ */
+
+uint32_t BMP280_DevGetMeasurementTimeUs(const bmp280_dev_t *dev) {
+    return dev->meas_time_us;
+}
+
+/**
+ * @brief Devuelve el período entre resultados nuevos, en µs.
+ *
+ * @details
+ * - Modo normal: `t_meas + t_standby`.
+ * - Modo forzado: `t_meas`, el mínimo entre disparos consecutivos.
+ *
+ * Se usa el tiempo máximo de medición, por lo que el período devuelto nunca es menor que el
+ * real: consultando el sensor a este ritmo cada lectura corresponde a una conversión nueva
+ * (a lo sumo se omite alguna), en lugar de repetir la anterior.
+ */
+
+uint32_t BMP280_DevGetSamplePeriodUs(const bmp280_dev_t *dev) {
+    if (dev->settings.mode == BMP280_OPMODE_FORCED) return dev->meas_time_us;
+    return dev->meas_time_us + standby_us[dev->settings.standby];
+}
+
+/**
+ * @brief Dispara una única conversión en modo forzado.
+ *
+ * @return `false` si el sensor no está configurado en modo forzado, hay una adquisición DMA en
+ *         curso (propia o del secuenciador) o ya hay una conversión disparada pendiente de `BMP280_IsConversionDone()`;
+ *         `true` si la conversión fue disparada.
+ *
+ * @details
+ * 1. Escribe `CTRL_MEAS` con el oversampling activo y `mode = 01` (forzado).
+ * 2. Guarda el instante del disparo (`delayGetMicros()`); el resultado estará disponible tras
+ *    `BMP280_GetMeasurementTimeUs()`, y el sensor vuelve solo a sleep al terminar.
+ *
+ * @note
+ * - Variante no bloqueante: el llamador consulta `BMP280_IsConversionDone()` (sin acceder al bus)
+ *   y luego lee con `BMP280_StartAcquisition()` / `BMP280_GetAcquisitionResult()`.
+ *
+ * @example
+ * ```c
+ * // Tarea periódica (período >= BMP280_GetSamplePeriodUs())
+ * if (BMP280_GetAcquisitionResult(&m)) { ... }      // muestra de la ejecución anterior
+ * if (BMP280_IsConversionDone()) BMP280_StartAcquisition();
+ * else BMP280_TriggerConversion();                    // no hace nada si ya hay una pendiente
+ * ```
+ */
+
+bool_t BMP280_DevTriggerConversion(bmp280_dev_t *dev) {
+    if (dev->settings.mode != BMP280_OPMODE_FORCED || dev->acq_state == BMP280_ACQ_BUSY ||
+        seq_state == BMP280_ACQ_BUSY || dev->forced_pending) return false;
+
+    BMP280_WriteRegister(dev, BMP280_REG_CTRL_MEAS, dev->ctrl_meas_osrs | BMP280_MODE_FORCED);
+    dev->forced_start_us = delayGetMicros();
+    dev->forced_pending = true;
+    return true;
+}
+
+/**
+ * @brief Indica si la conversión disparada con `BMP280_TriggerConversion()` ya terminó.
+ *
+ * @return `true` una única vez por disparo, cuando transcurrió el tiempo máximo de medición.
+ *
+ * @details
+ * Solo compara tiempos, no accede al bus. Para consultar el sensor usar `BMP280_IsMeasuring()`.
+ */
 
-    uint8_t config[2] = {BMP280_REG_CONFIG, 0xA0};
-    BMP280_PortSPI_WriteRegister(config, 2);
-    uint8_t ctrl_meas[2] = {BMP280_REG_CTRL_MEAS, 0x27};
-    BMP280_PortSPI_WriteRegister(ctrl_meas, 2);
+bool_t BMP280_DevIsConversionDone(bmp280_dev_t *dev) {
+    if (!dev->forced_pending) return false;
+    if ((uint32_t)(delayGetMicros() - dev->forced_start_us) < dev->meas_time_us) return false;
+    dev->forced_pending = false;
+    return true;
+}
+
+/**
+ * @brief Lee el bit `measuring` del registro de estado (`0xF3`).
+ *
+ * @return `true` mientras hay una conversión en curso.
+ */
+
+bool_t BMP280_DevIsMeasuring(bmp280_dev_t *dev) {
+    return (BMP280_ReadRegister(dev, BMP280_REG_STATUS) & BMP280_STATUS_MEASURING) != 0;
+}
+
+/**
+ * @brief Toma una muestra nueva en modo forzado, de forma bloqueante.
+ *
+ * @param data Estructura donde se guardan temperatura (°C) y presión (hPa).
+ *
+ * @details
+ * 1. Dispara la conversión con `BMP280_TriggerConversion()`.
+ * 2. Espera el tiempo típico de medición con `delayUs()` sin ocupar el bus.
+ * 3. Consulta el bit `measuring` de `0xF3` hasta que se borre, con un límite igual al tiempo
+ *    máximo de medición.
+ * 4. Lee el resultado en ráfaga con `BMP280_ReadAll()`.
+ *
+ * @note
+ * - La muestra corresponde siempre a una conversión iniciada por esta llamada; la latencia es
+ *   `t_meas` (por ejemplo ~6.4 ms con x1/x1, ~43 ms con x16/x2).
+ * - Si el sensor no está en modo forzado se informa y se llama a `Error_Handler()`.
+ */
+
+void BMP280_DevReadForced(bmp280_dev_t *dev, BMP280_Measurement *data) {
+    BMP280_WaitIdle(dev);
+    dev->forced_pending = false;
+    if (!BMP280_DevTriggerConversion(dev)) {
+        LOG("BMP280 NOT IN FORCED MODE");
+        Error_Handler();
+    }
+
+    delayUs(dev->meas_time_typ_us);
+    while (BMP280_DevIsMeasuring(dev) &&
+           (uint32_t)(delayGetMicros() - dev->forced_start_us) < dev->meas_time_us) {
+    }
+    dev->forced_pending = false;
+
+    BMP280_DevReadAll(dev, data);
+}
+
+static uint32_t BMP280_OversamplingCount(BMP280_Oversampling osrs) {
+    return (osrs == BMP280_OSRS_SKIP) ? 0 : (1U << (osrs - 1));
 }
 
 /**
@@ -233,10 +458,8 @@ void BMP280_Init(void) {
  *    ```
  *    adc_T = (MSB << 12) | (LSB << 4) | (XLSB >> 4)
  *    ```
- * 3. Se aplican las fórmulas de compensación oficiales (int32) que dependen de los coeficientes:
- *    - `dig_T1`, `dig_T2`, `dig_T3`
- * 4. El valor intermedio `t_fine` se guarda globalmente, ya que se utiliza luego para calcular la presión.
- * 5. La temperatura final se devuelve como número flotante dividiendo el resultado entero por 100.0.
+ * 3. Se compensa con `BMP280_CompensateTemperature()` (coeficientes precalculados de `dig_T1..dig_T3`).
+ * 4. El valor intermedio `t_fine` se guarda en el descriptor, ya que se utiliza luego para calcular la presión.
  *
  * @note
  * - Es obligatorio haber ejecutado previamente `BMP280_ReadCalibrationData()` para que los coeficientes estén cargados.
@@ -245,22 +468,13 @@ void BMP280_Init(void) {
  */
 
 float BMP280_ReadTemperature(void) {
+    bmp280_dev_t *dev = &bmp280_default;
     uint8_t raw_data[3];
-    uint8_t reg = BMP280_REG_TEMP_MSB | 0x80;
-    BMP280_SPI_CS_Select();
-    BMP280_PortSPI_WriteRegister(&reg, 1);
-    BMP280_PortSPI_ReadRegister(raw_data, 3);
-    BMP280_SPI_CS_Deselect();
+    BMP280_PortSPI_Read(&dev->spi, BMP280_REG_TEMP_MSB, raw_data, 3);
 
     int32_t adc_T = (int32_t)(((uint32_t)raw_data[0] << 12) | ((uint32_t)raw_data[1] << 4) | (raw_data[2] >> 4));
 
-    int32_t var1 = ((((adc_T >> 3) - ((int32_t)dig_T1 << 1))) * ((int32_t)dig_T2)) >> 11;
-    int32_t var2 = (((((adc_T >> 4) - ((int32_t)dig_T1)) * ((adc_T >> 4) - ((int32_t)dig_T1))) >> 12) *
-                   ((int32_t)dig_T3)) >> 14;
-
-    t_fine = var1 + var2;
-    float T = (t_fine * 5 + 128) >> 8;
-    return T / 100.0f;
+    return BMP280_CompensateTemperature(dev, adc_T);
 }
 
 /**
@@ -274,9 +488,8 @@ float BMP280_ReadTemperature(void) {
  *
  * @details
  * 1. Se leen 3 bytes desde los registros de presión (`MSB`, `LSB`, `XLSB`) y se reconstruye el valor `adc_P` de 20 bits.
- * 2. Se aplican las fórmulas oficiales de compensación usando variables `int64_t` para mantener la precisión.
+ * 2. Se compensa con `BMP280_CompensatePressure()`, según el back-end `BMP280_COMP_BACKEND`.
  * 3. El cálculo requiere que `t_fine` haya sido actualizado previamente llamando a `BMP280_ReadTemperature()`.
- * 4. El resultado se devuelve como número flotante dividiendo entre 25600.0, convirtiendo los pascales en hPa.
  *
  * @note
  * - La función depende de `t_fine`, por lo que **debe llamarse después de `BMP280_ReadTemperature()`**.
@@ -286,31 +499,64 @@ float BMP280_ReadTemperature(void) {
  */
 
 float BMP280_ReadPressure(void) {
+    bmp280_dev_t *dev = &bmp280_default;
     uint8_t raw_data[3];
-    uint8_t reg = BMP280_REG_PRESS_MSB | 0x80;
-    BMP280_SPI_CS_Select();
-    BMP280_PortSPI_WriteRegister(&reg, 1);
-    BMP280_PortSPI_ReadRegister(raw_data, 3);
-    BMP280_SPI_CS_Deselect();
+    BMP280_PortSPI_Read(&dev->spi, BMP280_REG_PRESS_MSB, raw_data, 3);
 
     int32_t adc_P = (int32_t)(((uint32_t)raw_data[0] << 12) | ((uint32_t)raw_data[1] << 4) | (raw_data[2] >> 4));
 
-    int64_t var1 = ((int64_t)t_fine) - 128000;
-    int64_t var2 = var1 * var1 * (int64_t)dig_P6;
-    var2 = var2 + ((var1 * (int64_t)dig_P5) << 17);
-    var2 = var2 + (((int64_t)dig_P4) << 35);
-    var1 = ((var1 * var1 * (int64_t)dig_P3) >> 8) + ((var1 * (int64_t)dig_P2) << 12);
-    var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)dig_P1) >> 33;
+    return BMP280_CompensatePressure(dev, adc_P);
+}
 
-    if (var1 == 0) return 0; // Evitar división por cero
+/**
+ * @brief Compensa el valor crudo de temperatura con el back-end elegido (`BMP280_COMP_BACKEND`).
+ *
+ * @param dev   Sensor al que pertenece la muestra (coeficientes de calibración propios).
+ * @param adc_T Valor ADC de temperatura de 20 bits.
+ *
+ * @return Temperatura en °C (float).
+ *
+ * @details
+ * - Actualiza `dev->t_fine`, que luego es requerido por `BMP280_CompensatePressure()`.
+ * - Los back-ends enteros comparten la fórmula de 32 bits de Bosch; el de `float` usa la FPU.
+ */
+
+static float BMP280_CompensateTemperature(bmp280_dev_t *dev, int32_t adc_T)
+{
+#if BMP280_COMP_BACKEND == BMP280_COMP_FLOAT
+    return BMP280_CompTemperatureFloat(&dev->comp, adc_T, &dev->t_fine);
+#else
+    return BMP280_CompTemperatureInt32(&dev->comp, adc_T, &dev->t_fine) * 0.01f;
+#endif
+}
 
-    int64_t p = 1048576 - adc_P;
-    p = (((p << 31) - var2) * 3125) / var1;
-    var1 = (((int64_t)dig_P9) * (p >> 13) * (p >> 13)) >> 25;
-    var2 = (((int64_t)dig_P8) * p) >> 19;
+/**
+ * @brief Compensa el valor crudo de presión con el back-end elegido (`BMP280_COMP_BACKEND`).
+ *
+ * @param dev   Sensor al que pertenece la muestra.
+ * @param adc_P Valor ADC de presión de 20 bits.
+ *
+ * @return Presión en hPa (float).
+ *
+ * @details
+ * - `BMP280_COMP_FLOAT` (por defecto): error < 0.5 Pa frente a la referencia de 64 bits.
+ * - `BMP280_COMP_INT32`: solo enteros de 32 bits, error de algunos Pa (resolución de 1 Pa).
+ * - `BMP280_COMP_INT64`: referencia de Bosch; enlaza la división de 64 bits por software.
+ *
+ * @note
+ * - Depende de `t_fine`, por lo que debe llamarse después de `BMP280_CompensateTemperature()`
+ *   con la temperatura de la misma conversión.
+ */
 
-    p = ((p + var1 + var2) >> 8) + (((int64_t)dig_P7) << 4);
-    return (float)p / 25600.0f;
+static float BMP280_CompensatePressure(bmp280_dev_t *dev, int32_t adc_P)
+{
+#if BMP280_COMP_BACKEND == BMP280_COMP_FLOAT
+    return BMP280_CompPressureFloat(&dev->comp, adc_P, dev->t_fine) * 0.01f;
+#elif BMP280_COMP_BACKEND == BMP280_COMP_INT32
+    return BMP280_CompPressureInt32(&dev->comp, adc_P, dev->t_fine) * 0.01f;
+#else
+    return BMP280_CompPressureInt64(&dev->comp, adc_P, dev->t_fine) * (1.0f / 25600.0f);
+#endif
 }
 
 /**
@@ -325,8 +571,9 @@ float BMP280_ReadPressure(void) {
  * @return Altitud estimada en metros (float).
  *
  * @details
- * 1. Llama a `BMP280_ReadPressure()` para obtener la presión atmosférica actual en hPa.
- * 2. Aplica la **fórmula barométrica estándar**:
+ * 1. Llama a `BMP280_ReadAll()` para obtener la presión actual en hPa, compensada con la temperatura
+ *    de la misma conversión.
+ * 2. Aplica la **fórmula barométrica estándar** mediante `BMP280_CalcAltitude()`:
  *    ```
  *    Altitud = 44330 × (1 - (P / P0)^0.1903)
  *    ```
@@ -338,11 +585,343 @@ float BMP280_ReadPressure(void) {
  * @note
  * - Este cálculo es una estimación y puede verse afectado por condiciones de temperatura, humedad y presión local.
  * - Es útil para aplicaciones como sensores de altura, altímetros, estaciones meteorológicas, etc.
- * - La función depende de `BMP280_ReadPressure()`, el cual **requiere** que se haya actualizado `t_fine` mediante `BMP280_ReadTemperature()` previamente.
+ * - Si ya se dispone de una medición, usar `BMP280_CalcAltitude()` para no volver a acceder al bus.
  *
  */
 
 float BMP280_ReadAltitude(float sea_level_hPa) {
-    float pressure_hPa = BMP280_ReadPressure();
-    return 44330.0f * (1.0f - powf(pressure_hPa / sea_level_hPa, 0.1903f));
+    BMP280_Measurement data;
+    BMP280_ReadAll(&data);
+    return BMP280_CalcAltitude(data.pressure, sea_level_hPa);
+}
+
+/**
+ * @brief Lee presión y temperatura de una misma conversión en una única ráfaga SPI.
+ *
+ * Esta función lee los 6 registros de datos `0xF7..0xFC` (presión MSB/LSB/XLSB y temperatura
+ * MSB/LSB/XLSB) en una sola transacción con CS activo. Durante una lectura en ráfaga el BMP280
+ * bloquea sus registros sombra, por lo que ambos valores pertenecen a la misma medición.
+ *
+ * @param dev  Sensor a leer.
+ * @param data Puntero a la estructura donde se guardan temperatura (°C) y presión (hPa).
+ *
+ * @details
+ * Es una envoltura bloqueante sobre el motor asíncrono:
+ * 1. Espera a que termine cualquier adquisición en curso y lanza una nueva con `BMP280_StartAcquisition()`.
+ * 2. Espera a que la DMA complete la ráfaga.
+ * 3. Obtiene el resultado compensado con `BMP280_GetAcquisitionResult()`.
+ *
+ * @note
+ * - Reemplaza la secuencia `BMP280_ReadTemperature()` + `BMP280_ReadPressure()` + `BMP280_ReadAltitude()`
+ *   (3 transacciones) por una sola.
+ * - Para la altitud usar `BMP280_CalcAltitude(data.pressure, p0)`, que no accede al bus.
+ * - Si la transferencia falla se informa por UART y se llama a `Error_Handler()`.
+ *
+ * @example
+ * ```c
+ * BMP280_Measurement m;
+ * BMP280_ReadAll(&m);
+ * float alt = BMP280_CalcAltitude(m.pressure, 1013.25f);
+ * ```
+ */
+
+void BMP280_DevReadAll(bmp280_dev_t *dev, BMP280_Measurement *data) {
+    while (!BMP280_DevStartAcquisition(dev)) {
+    }
+    while (dev->acq_state == BMP280_ACQ_BUSY) {
+    }
+    if (!BMP280_DevGetAcquisitionResult(dev, data)) {
+        LOG("ERROR HANDLER BMP280 DMA!");
+        Error_Handler();
+    }
+}
+
+/**
+ * @brief Convierte los 6 bytes de una ráfaga `0xF7..0xFC` en temperatura y presión compensadas.
+ *
+ * @param dev      Sensor al que pertenece la ráfaga.
+ * @param raw_data Bytes leídos (presión MSB/LSB/XLSB, temperatura MSB/LSB/XLSB).
+ * @param data     Estructura de salida.
+ *
+ * @details
+ * Se compensa primero la temperatura, que actualiza `t_fine`, y luego la presión con ese mismo `t_fine`.
+ */
+
+static void BMP280_ConvertBurst(bmp280_dev_t *dev, const uint8_t *raw_data, BMP280_Measurement *data) {
+    int32_t adc_P = (int32_t)(((uint32_t)raw_data[0] << 12) | ((uint32_t)raw_data[1] << 4) | (raw_data[2] >> 4));
+    int32_t adc_T = (int32_t)(((uint32_t)raw_data[3] << 12) | ((uint32_t)raw_data[4] << 4) | (raw_data[5] >> 4));
+
+    data->temperature = BMP280_CompensateTemperature(dev, adc_T);
+    data->pressure = BMP280_CompensatePressure(dev, adc_P);
+}
+
+/**
+ * @brief Inicia una adquisición no bloqueante de presión y temperatura por SPI con DMA.
+ *
+ * Lanza una transferencia full-duplex de 7 bytes (dirección `0xF7` con bit de lectura + 6 bytes de datos)
+ * mediante `BMP280_PortSPI_TransferDMA()` y retorna inmediatamente, dejando la CPU libre mientras dura la ráfaga.
+ *
+ * @param dev Sensor a leer.
+ *
+ * @return `true` si la adquisición fue lanzada, `false` si ya hay una en curso o la cola del bus SPI está llena.
+ *
+ * @details
+ * Máquina de estados de la adquisición:
+ * ```
+ * IDLE/READY/ERROR --Start--> BUSY --DMA OK--> READY --GetResult--> IDLE
+ *                                  --DMA error--> ERROR
+ * ```
+ * Un resultado en `READY` no leído se descarta si se lanza una nueva adquisición.
+ *
+ * @note
+ * - El driver solo depende de las funciones de `bmp280_port`, por lo que el motor puede ejecutarse
+ *   sobre un puerto SPI simulado.
+ * - La ráfaga se encola en `spi_bus`: si el bus está ocupado por otro dispositivo, se lanza al liberarse.
+ * - Las funciones bloqueantes de registro esperan a que la cola del bus se vacíe antes de tomarlo.
+ */
+
+bool_t BMP280_DevStartAcquisition(bmp280_dev_t *dev) {
+    if (dev->acq_state == BMP280_ACQ_BUSY || seq_state == BMP280_ACQ_BUSY) return false;
+
+    dev->acq_state = BMP280_ACQ_BUSY;
+    if (BMP280_PortSPI_TransferDMA(&dev->spi, dev->acq_tx, dev->acq_rx, sizeof(dev->acq_tx),
+                                   BMP280_AcquisitionComplete, dev) != HAL_OK) {
+        dev->acq_state = BMP280_ACQ_IDLE;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Devuelve el estado actual de la adquisición asíncrona.
+ *
+ * @return `BMP280_ACQ_IDLE`, `BMP280_ACQ_BUSY`, `BMP280_ACQ_READY` o `BMP280_ACQ_ERROR`.
+ */
+
+BMP280_AcqState BMP280_DevGetAcquisitionState(const bmp280_dev_t *dev) {
+    return dev->acq_state;
+}
+
+/**
+ * @brief Obtiene el resultado compensado de la última adquisición asíncrona.
+ *
+ * @param dev  Sensor a consultar.
+ * @param data Estructura donde se guardan temperatura (°C) y presión (hPa).
+ *
+ * @return `true` si había un resultado listo (`BMP280_ACQ_READY`), `false` en cualquier otro estado.
+ *
+ * @details
+ * La compensación se realiza aquí, en el contexto del llamador, y no dentro de la interrupción.
+ * Tras leer el resultado (o un error) el estado vuelve a `BMP280_ACQ_IDLE`.
+ */
+
+bool_t BMP280_DevGetAcquisitionResult(bmp280_dev_t *dev, BMP280_Measurement *data) {
+    if (dev->acq_state != BMP280_ACQ_READY) {
+        if (dev->acq_state == BMP280_ACQ_ERROR) dev->acq_state = BMP280_ACQ_IDLE;
+        return false;
+    }
+
+    BMP280_ConvertBurst(dev, &dev->acq_rx[1], data);
+    dev->acq_state = BMP280_ACQ_IDLE;
+    return true;
+}
+
+/**
+ * @brief Callback de fin de transferencia DMA (contexto de interrupción).
+ *
+ * @param status  `HAL_OK` si la ráfaga terminó correctamente.
+ * @param context Sensor que lanzó la adquisición (`bmp280_dev_t *`).
+ */
+
+static void BMP280_AcquisitionComplete(HAL_StatusTypeDef status, void *context) {
+    bmp280_dev_t *dev = context;
+    dev->acq_state = (status == HAL_OK) ? BMP280_ACQ_READY : BMP280_ACQ_ERROR;
+}
+
+/**
+ * @brief Lanza la lectura en ráfaga de varios sensores del bus, una detrás de otra.
+ *
+ * @param devs  Sensores a leer, ya inicializados con `BMP280_DevInit()`.
+ * @param count Cantidad de sensores (1..`BMP280_SEQ_MAX_DEVICES`).
+ *
+ * @return `false` si `count` está fuera de rango, hay una secuencia o una adquisición en curso, o el
+ *         la cola del bus SPI está llena; `true` si la secuencia fue lanzada.
+ *
+ * @details
+ * 1. Todos los sensores pasan a `BMP280_ACQ_BUSY` y se lanza la ráfaga del primero.
+ * 2. Al terminar cada DMA, `BMP280_SeqStep()` (en la interrupción) libera su CS, guarda el estado
+ *    del sensor y lanza directamente la ráfaga del siguiente.
+ * 3. Tras el último, `BMP280_SeqGetState()` pasa a `BMP280_ACQ_READY`.
+ *
+ * El costo de CPU es una interrupción por sensor y no depende de la tarea que llama: N sensores
+ * ocupan el bus ~N × 7 bytes seguidos, sin volver al scheduler entre uno y otro. Los resultados se
+ * obtienen y compensan en el contexto del llamador con `BMP280_DevGetAcquisitionResult()`.
+ *
+ * @note
+ * - Las funciones bloqueantes de registro de cualquier sensor esperan a que termine la secuencia,
+ *   ya que toman el bus con `SPI_Bus_Acquire()`.
+ *
+ * @example
+ * ```c
+ * static bmp280_dev_t *const baros[] = { &baro_a, &baro_b };
+ * // Tarea periódica
+ * if (BMP280_SeqGetState() == BMP280_ACQ_BUSY) return;
+ * BMP280_DevGetAcquisitionResult(&baro_a, &a);
+ * BMP280_DevGetAcquisitionResult(&baro_b, &b);
+ * float diff_hpa = a.pressure - b.pressure;
+ * BMP280_SeqStart(baros, 2);
+ * ```
+ */
+
+bool_t BMP280_SeqStart(bmp280_dev_t *const *devs, uint8_t count) {
+    if (count == 0 || count > BMP280_SEQ_MAX_DEVICES || seq_state == BMP280_ACQ_BUSY) return false;
+    for (uint8_t i = 0; i < count; i++) {
+        if (devs[i]->acq_state == BMP280_ACQ_BUSY) return false;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        seq_devs[i] = devs[i];
+        devs[i]->acq_state = BMP280_ACQ_BUSY;
+    }
+    seq_count = count;
+    seq_index = 0;
+    seq_state = BMP280_ACQ_BUSY;
+
+    bmp280_dev_t *first = seq_devs[0];
+    if (BMP280_PortSPI_TransferDMA(&first->spi, first->acq_tx, first->acq_rx, sizeof(first->acq_tx),
+                                   BMP280_SeqStep, first) != HAL_OK) {
+        for (uint8_t i = 0; i < count; i++) seq_devs[i]->acq_state = BMP280_ACQ_IDLE;
+        seq_state = BMP280_ACQ_IDLE;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Devuelve el estado de la última secuencia lanzada con `BMP280_SeqStart()`.
+ *
+ * @return `BMP280_ACQ_BUSY` mientras queda algún sensor por leer, `BMP280_ACQ_READY` al terminar
+ *         (el resultado o error de cada sensor está en su propio descriptor) o `BMP280_ACQ_IDLE`.
+ */
+
+BMP280_AcqState BMP280_SeqGetState(void) {
+    return seq_state;
+}
+
+/**
+ * @brief Paso del secuenciador: fin de la ráfaga de un sensor (contexto de interrupción).
+ *
+ * @param status  `HAL_OK` si la ráfaga terminó correctamente.
+ * @param context Sensor cuya ráfaga terminó; el puerto ya liberó su CS.
+ *
+ * @details
+ * Si el lanzamiento del siguiente sensor falla, ese sensor queda en `BMP280_ACQ_ERROR` y se
+ * intenta con el próximo, de modo que la secuencia siempre termina.
+ */
+
+static void BMP280_SeqStep(HAL_StatusTypeDef status, void *context) {
+    BMP280_AcquisitionComplete(status, context);
+
+    while (++seq_index < seq_count) {
+        bmp280_dev_t *next = seq_devs[seq_index];
+        if (BMP280_PortSPI_TransferDMA(&next->spi, next->acq_tx, next->acq_rx, sizeof(next->acq_tx),
+                                       BMP280_SeqStep, next) == HAL_OK) return;
+        next->acq_state = BMP280_ACQ_ERROR;
+    }
+    seq_state = BMP280_ACQ_READY;
+}
+
+/**
+ * @brief Espera a que el sensor y el secuenciador de bus terminen sus transferencias DMA.
+ */
+
+static void BMP280_WaitIdle(const bmp280_dev_t *dev) {
+    while (dev->acq_state == BMP280_ACQ_BUSY || seq_state == BMP280_ACQ_BUSY) {
+    }
+}
+
+/**
+ * @brief Calcula la altitud (en metros) a partir de una presión ya medida.
+ *
+ * @param pressure_hPa  Presión medida en hPa (por ejemplo, `BMP280_Measurement.pressure`).
+ * @param sea_level_hPa Presión de referencia a nivel del mar en hPa.
+ *
+ * @return Altitud estimada en metros (float).
+ *
+ * @details
+ * Aplica la fórmula barométrica estándar `Altitud = 44330 × (1 - (P / P0)^0.1903)` sin realizar
+ * ninguna transacción SPI. Se evalúa con `altitudeFromPressure()` (tabla e interpolación, error
+ * máximo de 0.16 m) en lugar de `powf`. Para lotes de muestras usar `altitudeFromPressureBatch()`.
+ */
+
+float BMP280_CalcAltitude(float pressure_hPa, float sea_level_hPa) {
+    return altitudeFromPressure(pressure_hPa, sea_level_hPa);
+}
+
+/*
+ * API de un solo sensor: envolturas sobre el sensor por defecto (CS en BMP280_CS_PIN).
+ */
+
+void BMP280_Init(void) {
+    BMP280_DevInit(&bmp280_default, BMP280_CS_GPIO_PORT, BMP280_CS_PIN);
+}
+
+uint8_t BMP280_Read8(uint8_t reg) {
+    return BMP280_DevRead8(&bmp280_default, reg);
+}
+
+void BMP280_Write8(uint8_t reg, uint8_t value) {
+    BMP280_DevWrite8(&bmp280_default, reg, value);
+}
+
+bool_t BMP280_SetProfile(BMP280_Profile profile) {
+    return BMP280_DevSetProfile(&bmp280_default, profile);
+}
+
+bool_t BMP280_Configure(const BMP280_Settings *settings) {
+    return BMP280_DevConfigure(&bmp280_default, settings);
+}
+
+void BMP280_GetSettings(BMP280_Settings *settings) {
+    BMP280_DevGetSettings(&bmp280_default, settings);
+}
+
+uint32_t BMP280_GetMeasurementTimeUs(void) {
+    return BMP280_DevGetMeasurementTimeUs(&bmp280_default);
+}
+
+uint32_t BMP280_GetSamplePeriodUs(void) {
+    return BMP280_DevGetSamplePeriodUs(&bmp280_default);
+}
+
+bool_t BMP280_TriggerConversion(void) {
+    return BMP280_DevTriggerConversion(&bmp280_default);
+}
+
+bool_t BMP280_IsConversionDone(void) {
+    return BMP280_DevIsConversionDone(&bmp280_default);
+}
+
+bool_t BMP280_IsMeasuring(void) {
+    return BMP280_DevIsMeasuring(&bmp280_default);
+}
+
+void BMP280_ReadForced(BMP280_Measurement *data) {
+    BMP280_DevReadForced(&bmp280_default, data);
+}
+
+void BMP280_ReadAll(BMP280_Measurement *data) {
+    BMP280_DevReadAll(&bmp280_default, data);
+}
+
+bool_t BMP280_StartAcquisition(void) {
+    return BMP280_DevStartAcquisition(&bmp280_default);
+}
+
+BMP280_AcqState BMP280_GetAcquisitionState(void) {
+    return BMP280_DevGetAcquisitionState(&bmp280_default);
+}
+
+bool_t BMP280_GetAcquisitionResult(BMP280_Measurement *data) {
+    return BMP280_DevGetAcquisitionResult(&bmp280_default, data);
 }
@@ -7,65 +7,226 @@
 
 
 #include "bmp280_port.h"
-#include "API_uart.h"
+#include "API_log.h"
+#include "stm32f4xx_ll_spi.h"
+#include "stm32f4xx_ll_gpio.h"
+#if BMP280_PORT_BENCHMARK
+#include "API_delay.h"
+#endif
 
-static SPI_HandleTypeDef hspi2;
+#define BMP280_PORT_USE_HAL  (BMP280_PORT_BACKEND == BMP280_PORT_HAL || BMP280_PORT_BENCHMARK)
+#define BMP280_PORT_USE_LL   (BMP280_PORT_BACKEND == BMP280_PORT_LL || BMP280_PORT_BENCHMARK)
+#define BMP280_BENCH_RUNS    16
 
+static SPI_BusDevice default_spi;
+
+#if BMP280_PORT_USE_HAL
+static void BMP280_PortHAL_Read(const SPI_BusDevice *spi, uint8_t reg, uint8_t *data, uint16_t size);
+static void BMP280_PortHAL_Write(const SPI_BusDevice *spi, uint8_t reg, uint8_t value);
+#endif
+#if BMP280_PORT_USE_LL
+static void BMP280_PortLL_Read(const SPI_BusDevice *spi, uint8_t reg, uint8_t *data, uint16_t size);
+static void BMP280_PortLL_Write(const SPI_BusDevice *spi, uint8_t reg, uint8_t value);
+#endif
+
+/*
+ * SPI2, sus DMA e interrupciones pertenecen a spi_bus; se conserva el nombre para main.c.
+ */
 void BMP280_SPI_Init(void)
 {
-	  hspi2.Instance = SPI2;
-	  hspi2.Init.Mode = SPI_MODE_MASTER;
-	  hspi2.Init.Direction = SPI_DIRECTION_2LINES;
-	  hspi2.Init.DataSize = SPI_DATASIZE_8BIT;
-	  hspi2.Init.CLKPolarity = SPI_POLARITY_LOW;
-	  hspi2.Init.CLKPhase = SPI_PHASE_1EDGE;
-	  hspi2.Init.NSS = SPI_NSS_SOFT;
-	  hspi2.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_2;
-	  hspi2.Init.FirstBit = SPI_FIRSTBIT_MSB;
-	  hspi2.Init.TIMode = SPI_TIMODE_DISABLE;
-	  hspi2.Init.CRCCalculation = SPI_CRCCALCULATION_DISABLE;
-	  hspi2.Init.CRCPolynomial = 10;
-	  if (HAL_SPI_Init(&hspi2) != HAL_OK)
-	  {
-	    Error_Handler();
-	  }
+	SPI_Bus_Init();
 }
 
 void BMP280_SPI_CS_Init(void)
 {
-    GPIO_InitTypeDef GPIO_InitStruct = {0};
-    GPIO_InitStruct.Pin = GPIO_PIN_4;
-    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
-    GPIO_InitStruct.Pull = GPIO_NOPULL;
-    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
-    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
-    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_4, GPIO_PIN_SET);
+	BMP280_PortSPI_DeviceInit(&default_spi, BMP280_CS_GPIO_PORT, BMP280_CS_PIN);
+}
+
+/*
+ * Declara un sensor en el bus SPI2: CS como salida en alto y el prescaler más rápido que no
+ * supere BMP280_SPI_MAX_CLOCK (con PCLK1 = 42 MHz, /8 = 5.25 MHz). Con varios sensores en el bus
+ * se deben declarar todos antes de la primera transacción, para que ningún sensor con el CS
+ * flotante responda en MISO.
+ */
+void BMP280_PortSPI_DeviceInit(SPI_BusDevice *spi, GPIO_TypeDef *cs_port, uint16_t cs_pin)
+{
+	if (!SPI_Bus_DeviceInit(spi, cs_port, cs_pin, BMP280_SPI_MAX_CLOCK, BMP280_SPI_MODE))
+	{
+		LOG("ERROR HANDLER BMP280 SPI CLOCK! cs=0x%04X", cs_pin);
+		Error_Handler();
+	}
+}
+
+/*
+ * Lectura bloqueante de `size` registros consecutivos desde `reg`, con el CS incluido.
+ * Toma el bus (espera la cola DMA y carga el reloj/modo del sensor) y lo libera al terminar.
+ * El back-end se elige al compilar con BMP280_PORT_BACKEND.
+ */
+void BMP280_PortSPI_Read(const SPI_BusDevice *spi, uint8_t reg, uint8_t *data, uint16_t size)
+{
+	SPI_Bus_Acquire(spi);
+#if BMP280_PORT_BACKEND == BMP280_PORT_LL
+	BMP280_PortLL_Read(spi, reg, data, size);
+#else
+	BMP280_PortHAL_Read(spi, reg, data, size);
+#endif
+	SPI_Bus_Release();
+}
+
+/*
+ * Escritura bloqueante de un registro, con el CS incluido.
+ */
+void BMP280_PortSPI_Write(const SPI_BusDevice *spi, uint8_t reg, uint8_t value)
+{
+	SPI_Bus_Acquire(spi);
+#if BMP280_PORT_BACKEND == BMP280_PORT_LL
+	BMP280_PortLL_Write(spi, reg, value);
+#else
+	BMP280_PortHAL_Write(spi, reg, value);
+#endif
+	SPI_Bus_Release();
 }
 
-void BMP280_PortSPI_WriteRegister(uint8_t *valor, uint8_t size)
+#if BMP280_PORT_USE_HAL
+static void BMP280_PortHAL_Read(const SPI_BusDevice *spi, uint8_t reg, uint8_t *data, uint16_t size)
 {
-	if(HAL_SPI_Transmit(&hspi2, valor , size, HAL_MAX_DELAY) != HAL_OK)
+	SPI_HandleTypeDef *hspi = SPI_Bus_GetHandle();
+	uint8_t tx = reg | 0x80;
+
+	SPI_Bus_Select(spi);
+	if (HAL_SPI_Transmit(hspi, &tx, 1, HAL_MAX_DELAY) != HAL_OK ||
+	    HAL_SPI_Receive(hspi, data, size, HAL_MAX_DELAY) != HAL_OK)
 	{
-		uartSendString((uint8_t*)"ERROR HANDLER BMP280 WRITE!\r\n");
+		LOG("ERROR HANDLER BMP280 READ! reg=0x%02X size=%u", reg, size);
 		Error_Handler();
 	}
+	SPI_Bus_Deselect(spi);
 }
 
-void BMP280_PortSPI_ReadRegister(uint8_t *valor, uint8_t size)
+static void BMP280_PortHAL_Write(const SPI_BusDevice *spi, uint8_t reg, uint8_t value)
 {
-	if(HAL_SPI_Receive(&hspi2, valor , size, HAL_MAX_DELAY) != HAL_OK)
+	uint8_t tx[2] = { reg & 0x7F, value };
+
+	SPI_Bus_Select(spi);
+	if (HAL_SPI_Transmit(SPI_Bus_GetHandle(), tx, sizeof(tx), HAL_MAX_DELAY) != HAL_OK)
 	{
-		uartSendString((uint8_t*)"ERROR HANDLER BMP280 READ!\r\n");
+		LOG("ERROR HANDLER BMP280 WRITE! reg=0x%02X", reg);
 		Error_Handler();
 	}
+	SPI_Bus_Deselect(spi);
 }
+#endif
+
+#if BMP280_PORT_USE_LL
+/*
+ * Back-end LL: full-duplex por consulta directa de SPI2->SR/DR y CS por BSRR.
+ * Por cada byte se escribe DR y se espera RXNE, así nunca hay OVR ni bytes pendientes; al
+ * entrar se descarta lo que haya dejado una transferencia HAL anterior (RXNE/OVR).
+ * Solo se usa con el bus tomado (SPI_Bus_Acquire), así que nunca pisa una DMA en curso.
+ */
+static void BMP280_PortLL_Begin(const SPI_BusDevice *spi)
+{
+	if (!LL_SPI_IsEnabled(SPI2)) LL_SPI_Enable(SPI2);
+	if (LL_SPI_IsActiveFlag_RXNE(SPI2)) (void)LL_SPI_ReceiveData8(SPI2);
+	LL_SPI_ClearFlag_OVR(SPI2);
+	LL_GPIO_ResetOutputPin(spi->cs_port, spi->cs_pin);
+}
+
+static uint8_t BMP280_PortLL_Transfer(uint8_t byte)
+{
+	while (!LL_SPI_IsActiveFlag_TXE(SPI2)) {
+	}
+	LL_SPI_TransmitData8(SPI2, byte);
+	while (!LL_SPI_IsActiveFlag_RXNE(SPI2)) {
+	}
+	return LL_SPI_ReceiveData8(SPI2);
+}
+
+static void BMP280_PortLL_End(const SPI_BusDevice *spi)
+{
+	while (LL_SPI_IsActiveFlag_BSY(SPI2)) {
+	}
+	LL_GPIO_SetOutputPin(spi->cs_port, spi->cs_pin);
+}
+
+static void BMP280_PortLL_Read(const SPI_BusDevice *spi, uint8_t reg, uint8_t *data, uint16_t size)
+{
+	BMP280_PortLL_Begin(spi);
+	(void)BMP280_PortLL_Transfer(reg | 0x80);
+	for (uint16_t i = 0; i < size; i++) data[i] = BMP280_PortLL_Transfer(0x00);
+	BMP280_PortLL_End(spi);
+}
+
+static void BMP280_PortLL_Write(const SPI_BusDevice *spi, uint8_t reg, uint8_t value)
+{
+	BMP280_PortLL_Begin(spi);
+	(void)BMP280_PortLL_Transfer(reg & 0x7F);
+	(void)BMP280_PortLL_Transfer(value);
+	BMP280_PortLL_End(spi);
+}
+#endif
+
+#if BMP280_PORT_BENCHMARK
+/*
+ * Mide con el contador DWT (requiere delayUsInit()) el costo de una lectura de 1 y de 24 bytes
+ * con cada back-end, CS incluido. Se toma el mínimo de BMP280_BENCH_RUNS corridas para no contar
+ * interrupciones. Las lecturas (ID y calibración) no modifican el estado del sensor.
+ */
+void BMP280_PortSPI_Benchmark(const SPI_BusDevice *spi, BMP280_PortBenchmark *result)
+{
+	uint8_t buf[24];
+
+	SPI_Bus_Acquire(spi);
+
+	result->hal_read1 = result->ll_read1 = UINT32_MAX;
+	result->hal_read24 = result->ll_read24 = UINT32_MAX;
+
+	for (uint32_t run = 0; run < BMP280_BENCH_RUNS; run++)
+	{
+		uint32_t start = delayGetCycles();
+		BMP280_PortHAL_Read(spi, 0xD0, buf, 1);
+		uint32_t cycles = delayGetCycles() - start;
+		if (cycles < result->hal_read1) result->hal_read1 = cycles;
+
+		start = delayGetCycles();
+		BMP280_PortLL_Read(spi, 0xD0, buf, 1);
+		cycles = delayGetCycles() - start;
+		if (cycles < result->ll_read1) result->ll_read1 = cycles;
+
+		start = delayGetCycles();
+		BMP280_PortHAL_Read(spi, 0x88, buf, sizeof(buf));
+		cycles = delayGetCycles() - start;
+		if (cycles < result->hal_read24) result->hal_read24 = cycles;
+
+		start = delayGetCycles();
+		BMP280_PortLL_Read(spi, 0x88, buf, sizeof(buf));
+		cycles = delayGetCycles() - start;
+		if (cycles < result->ll_read24) result->ll_read24 = cycles;
+	}
+	SPI_Bus_Release();
+}
+#endif
 
 void BMP280_SPI_CS_Select(void)
 {
-	HAL_GPIO_WritePin(GPIOA, GPIO_PIN_4, GPIO_PIN_RESET);
+	SPI_Bus_Select(&default_spi);
 }
 
 void BMP280_SPI_CS_Deselect(void)
 {
-	HAL_GPIO_WritePin(GPIOA, GPIO_PIN_4, GPIO_PIN_SET);
+	SPI_Bus_Deselect(&default_spi);
+}
+
+/*
+ * Transferencia full-duplex no bloqueante: se encola en spi_bus, que carga el reloj/modo del
+ * sensor, selecciona su CS y lanza la DMA cuando el bus queda libre. El CS se libera y se invoca
+ * `callback(status, context)` desde la interrupción de fin de transferencia; el callback puede
+ * encolar desde ahí la transferencia siguiente. Retorna HAL_BUSY si la cola está llena.
+ */
+HAL_StatusTypeDef BMP280_PortSPI_TransferDMA(const SPI_BusDevice *spi, const uint8_t *tx, uint8_t *rx, uint16_t size,
+                                             BMP280_PortSPI_Callback callback, void *context)
+{
+	SPI_Transaction xfer = { spi, tx, rx, size, callback, context };
+
+	return SPI_Bus_Submit(&xfer) ? HAL_OK : HAL_BUSY;
 }
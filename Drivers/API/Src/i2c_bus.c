@@ -0,0 +1,388 @@
+/*
+ * i2c_bus.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ */
+
+#include "i2c_bus.h"
+
+typedef struct
+{
+    I2C_TypeDef        *instance;
+    uint32_t           clock_speed;
+    IRQn_Type          ev_irq;
+    IRQn_Type          er_irq;
+    DMA_Stream_TypeDef *rx_stream;   // NULL: recepción por interrupción
+    uint32_t           rx_channel;
+    IRQn_Type          rx_irq;
+    DMA_Stream_TypeDef *tx_stream;   // NULL: transmisión por interrupción
+    uint32_t           tx_channel;
+    IRQn_Type          tx_irq;
+} I2C_BusConfig;
+
+typedef struct
+{
+    I2C_HandleTypeDef hi2c;
+    DMA_HandleTypeDef hdma_rx;
+    DMA_HandleTypeDef hdma_tx;
+    I2C_Transaction   queue[I2C_BUS_QUEUE_LENGTH];
+    volatile uint8_t  head;
+    volatile uint8_t  count;
+    volatile bool_t   active;
+    bool_t            initialized;
+} I2C_BusState;
+
+typedef struct
+{
+    volatile bool_t            done;
+    volatile HAL_StatusTypeDef status;
+} I2C_BlockingContext;
+
+/*
+ * I2C1_TX -> DMA1 Stream7 Channel1 (Stream6 queda para USART2_TX)
+ * I2C3_RX -> DMA1 Stream2 Channel3 (I2C3_TX comparte Stream4 con SPI2_TX, se usa interrupción)
+ */
+static const I2C_BusConfig bus_config[I2C_BUS_COUNT] =
+{
+    [I2C_BUS_1] = { I2C1, I2C_BUS1_CLOCK_SPEED, I2C1_EV_IRQn, I2C1_ER_IRQn,
+                    NULL, 0, 0,
+                    DMA1_Stream7, DMA_CHANNEL_1, DMA1_Stream7_IRQn },
+    [I2C_BUS_3] = { I2C3, I2C_BUS3_CLOCK_SPEED, I2C3_EV_IRQn, I2C3_ER_IRQn,
+                    DMA1_Stream2, DMA_CHANNEL_3, DMA1_Stream2_IRQn,
+                    NULL, 0, 0 },
+};
+
+static I2C_BusState buses[I2C_BUS_COUNT];
+
+static void I2C_Bus_DMA_Init(DMA_HandleTypeDef *hdma, DMA_Stream_TypeDef *stream, uint32_t channel, uint32_t direction, IRQn_Type irq);
+static void I2C_Bus_StartNext(I2C_BusState *state);
+static bool_t I2C_Bus_Advance(I2C_BusState *state);
+static void I2C_Bus_Complete(I2C_HandleTypeDef *hi2c, HAL_StatusTypeDef status);
+static void I2C_Bus_BlockingCallback(HAL_StatusTypeDef status, void *context);
+
+/**
+ * @brief Inicializa un bus I2C, sus canales DMA y sus interrupciones.
+ *
+ * Cada bus se inicializa una sola vez aunque varios puertos (LCD, MPU6050) llamen a esta función.
+ *
+ * @param bus Bus a inicializar (`I2C_BUS_1` o `I2C_BUS_3`).
+ *
+ * @details
+ * 1. Configura el periférico a la velocidad del bus (`I2C_BUS1_CLOCK_SPEED` / `I2C_BUS3_CLOCK_SPEED`)
+ *    en modo maestro de 7 bits.
+ * 2. Configura y vincula los streams DMA disponibles para ese bus (ver `bus_config`).
+ * 3. Habilita las interrupciones de evento y error del I2C, necesarias para los modos IT y DMA.
+ *
+ * @note
+ * - Ante un error de HAL se llama a `Error_Handler()`, igual que el resto de los puertos.
+ */
+
+void I2C_Bus_Init(I2C_BusId bus)
+{
+	I2C_BusState *state = &buses[bus];
+	const I2C_BusConfig *config = &bus_config[bus];
+
+	if (state->initialized) return;
+
+	state->hi2c.Instance = config->instance;
+	state->hi2c.Init.ClockSpeed = config->clock_speed;
+	state->hi2c.Init.DutyCycle = I2C_DUTYCYCLE_2;
+	state->hi2c.Init.OwnAddress1 = 0;
+	state->hi2c.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
+	state->hi2c.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
+	state->hi2c.Init.OwnAddress2 = 0;
+	state->hi2c.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
+	state->hi2c.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
+	if (HAL_I2C_Init(&state->hi2c) != HAL_OK)
+	{
+		Error_Handler();
+	}
+
+	if (config->rx_stream != NULL)
+	{
+		I2C_Bus_DMA_Init(&state->hdma_rx, config->rx_stream, config->rx_channel, DMA_PERIPH_TO_MEMORY, config->rx_irq);
+		__HAL_LINKDMA(&state->hi2c, hdmarx, state->hdma_rx);
+	}
+	if (config->tx_stream != NULL)
+	{
+		I2C_Bus_DMA_Init(&state->hdma_tx, config->tx_stream, config->tx_channel, DMA_MEMORY_TO_PERIPH, config->tx_irq);
+		__HAL_LINKDMA(&state->hi2c, hdmatx, state->hdma_tx);
+	}
+
+	HAL_NVIC_SetPriority(config->ev_irq, 0, 0);
+	HAL_NVIC_EnableIRQ(config->ev_irq);
+	HAL_NVIC_SetPriority(config->er_irq, 0, 0);
+	HAL_NVIC_EnableIRQ(config->er_irq);
+
+	state->head = 0;
+	state->count = 0;
+	state->active = false;
+	state->initialized = true;
+}
+
+static void I2C_Bus_DMA_Init(DMA_HandleTypeDef *hdma, DMA_Stream_TypeDef *stream, uint32_t channel, uint32_t direction, IRQn_Type irq)
+{
+	__HAL_RCC_DMA1_CLK_ENABLE();
+
+	hdma->Instance = stream;
+	hdma->Init.Channel = channel;
+	hdma->Init.Direction = direction;
+	hdma->Init.PeriphInc = DMA_PINC_DISABLE;
+	hdma->Init.MemInc = DMA_MINC_ENABLE;
+	hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdma->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	hdma->Init.Mode = DMA_NORMAL;
+	hdma->Init.Priority = DMA_PRIORITY_LOW;
+	hdma->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+	if (HAL_DMA_Init(hdma) != HAL_OK)
+	{
+		Error_Handler();
+	}
+
+	HAL_NVIC_SetPriority(irq, 0, 0);
+	HAL_NVIC_EnableIRQ(irq);
+}
+
+/**
+ * @brief Devuelve el handle HAL del bus, para operaciones puntuales como `HAL_I2C_IsDeviceReady`.
+ *
+ * @param bus Bus solicitado.
+ *
+ * @return Puntero al `I2C_HandleTypeDef` del bus.
+ *
+ * @note
+ * - Solo debe usarse directamente cuando el bus está inactivo (`I2C_Bus_IsIdle()`).
+ */
+
+I2C_HandleTypeDef *I2C_Bus_GetHandle(I2C_BusId bus)
+{
+	return &buses[bus].hi2c;
+}
+
+/**
+ * @brief Encola una transacción en el bus y retorna sin esperar a que se ejecute.
+ *
+ * La transacción se copia a la cola del bus. Si el bus está libre se lanza inmediatamente;
+ * si no, se lanzará desde la interrupción de fin de la transacción anterior.
+ *
+ * @param bus  Bus destino.
+ * @param xfer Descripción de la transacción. El buffer `xfer->data` debe seguir siendo válido
+ *             hasta que se invoque `xfer->callback`.
+ *
+ * @return `true` si la transacción fue encolada, `false` si la cola está llena.
+ *
+ * @details
+ * - Se usa DMA en la dirección que tenga un stream asignado y modo interrupción en la otra.
+ * - El callback se invoca en contexto de interrupción con el estado final (`HAL_OK` o `HAL_ERROR`).
+ * - Puede llamarse desde el lazo principal, desde otra interrupción o desde el callback de otra
+ *   transacción del mismo bus (la nueva se lanza al volver el callback).
+ */
+
+bool_t I2C_Bus_Submit(I2C_BusId bus, const I2C_Transaction *xfer)
+{
+	I2C_BusState *state = &buses[bus];
+	bool_t start = false;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	if (state->count >= I2C_BUS_QUEUE_LENGTH)
+	{
+		__set_PRIMASK(primask);
+		return false;
+	}
+
+	uint8_t slot = (state->head + state->count) % I2C_BUS_QUEUE_LENGTH;
+	state->queue[slot] = *xfer;
+	state->count++;
+
+	if (!state->active)
+	{
+		state->active = true;
+		start = true;
+	}
+
+	__set_PRIMASK(primask);
+
+	if (start) I2C_Bus_StartNext(state);
+	return true;
+}
+
+/**
+ * @brief Ejecuta una transacción de forma bloqueante a través de la cola del bus.
+ *
+ * Encola la transacción y espera a que se complete, respetando el orden de las transacciones
+ * asíncronas ya pendientes en el mismo bus.
+ *
+ * @param bus  Bus destino.
+ * @param xfer Transacción. Los campos `callback` y `context` se ignoran.
+ *
+ * @return Estado final de la transacción.
+ *
+ * @note
+ * - No debe llamarse desde una interrupción, ya que la espera depende de las interrupciones del bus.
+ */
+
+HAL_StatusTypeDef I2C_Bus_Transfer(I2C_BusId bus, const I2C_Transaction *xfer)
+{
+	I2C_BlockingContext blocking = { .done = false, .status = HAL_ERROR };
+	I2C_Transaction request = *xfer;
+
+	request.callback = I2C_Bus_BlockingCallback;
+	request.context = &blocking;
+
+	while (!I2C_Bus_Submit(bus, &request)) {
+	}
+	while (!blocking.done) {
+	}
+	return blocking.status;
+}
+
+/**
+ * @brief Indica si el bus no tiene transacciones activas ni pendientes.
+ *
+ * @param bus Bus consultado.
+ *
+ * @return `true` si la cola está vacía y no hay transferencia en curso.
+ */
+
+bool_t I2C_Bus_IsIdle(I2C_BusId bus)
+{
+	return !buses[bus].active;
+}
+
+static void I2C_Bus_BlockingCallback(HAL_StatusTypeDef status, void *context)
+{
+	I2C_BlockingContext *blocking = (I2C_BlockingContext *)context;
+	blocking->status = status;
+	blocking->done = true;
+}
+
+/*
+ * Lanza la transacción en la cabeza de la cola. Si la HAL la rechaza se completa con error
+ * y se pasa a la siguiente, de modo que un fallo nunca bloquea la cola.
+ */
+static void I2C_Bus_StartNext(I2C_BusState *state)
+{
+	while (1)
+	{
+		I2C_Transaction *xfer = &state->queue[state->head];
+		I2C_HandleTypeDef *hi2c = &state->hi2c;
+		HAL_StatusTypeDef status;
+
+		switch (xfer->type)
+		{
+		case I2C_XFER_TRANSMIT:
+			status = (hi2c->hdmatx != NULL)
+			       ? HAL_I2C_Master_Transmit_DMA(hi2c, xfer->dev_addr, xfer->data, xfer->size)
+			       : HAL_I2C_Master_Transmit_IT(hi2c, xfer->dev_addr, xfer->data, xfer->size);
+			break;
+		case I2C_XFER_MEM_READ:
+			status = (hi2c->hdmarx != NULL)
+			       ? HAL_I2C_Mem_Read_DMA(hi2c, xfer->dev_addr, xfer->mem_addr, I2C_MEMADD_SIZE_8BIT, xfer->data, xfer->size)
+			       : HAL_I2C_Mem_Read_IT(hi2c, xfer->dev_addr, xfer->mem_addr, I2C_MEMADD_SIZE_8BIT, xfer->data, xfer->size);
+			break;
+		case I2C_XFER_MEM_WRITE:
+			status = (hi2c->hdmatx != NULL)
+			       ? HAL_I2C_Mem_Write_DMA(hi2c, xfer->dev_addr, xfer->mem_addr, I2C_MEMADD_SIZE_8BIT, xfer->data, xfer->size)
+			       : HAL_I2C_Mem_Write_IT(hi2c, xfer->dev_addr, xfer->mem_addr, I2C_MEMADD_SIZE_8BIT, xfer->data, xfer->size);
+			break;
+		default:
+			status = HAL_ERROR;
+			break;
+		}
+
+		if (status == HAL_OK) return;
+
+		I2C_XferCallback callback = xfer->callback;
+		void *context = xfer->context;
+
+		uint32_t primask = __get_PRIMASK();
+		__disable_irq();
+		state->head = (state->head + 1) % I2C_BUS_QUEUE_LENGTH;
+		state->count--;
+		__set_PRIMASK(primask);
+
+		if (callback != NULL) callback(HAL_ERROR, context);
+		if (!I2C_Bus_Advance(state)) return;
+	}
+}
+
+/*
+ * Decide, ya invocado el callback de la transacción saliente, si el bus sigue activo.
+ * Mientras corre el callback `active` permanece en true, así un I2C_Bus_Submit() desde el
+ * callback solo encola y la transacción se lanza una única vez, desde quien llamó al callback.
+ */
+static bool_t I2C_Bus_Advance(I2C_BusState *state)
+{
+	bool_t more;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	more = (state->count > 0);
+	if (!more) state->active = false;
+	__set_PRIMASK(primask);
+
+	return more;
+}
+
+static void I2C_Bus_Complete(I2C_HandleTypeDef *hi2c, HAL_StatusTypeDef status)
+{
+	for (int bus = 0; bus < I2C_BUS_COUNT; bus++)
+	{
+		I2C_BusState *state = &buses[bus];
+		if (hi2c != &state->hi2c) continue;
+
+		I2C_Transaction *xfer = &state->queue[state->head];
+		I2C_XferCallback callback = xfer->callback;
+		void *context = xfer->context;
+
+		state->head = (state->head + 1) % I2C_BUS_QUEUE_LENGTH;
+		state->count--;
+
+		if (callback != NULL) callback(status, context);
+		if (I2C_Bus_Advance(state)) I2C_Bus_StartNext(state);
+		return;
+	}
+}
+
+void I2C_Bus_EV_IRQHandler(I2C_BusId bus)
+{
+	HAL_I2C_EV_IRQHandler(&buses[bus].hi2c);
+}
+
+void I2C_Bus_ER_IRQHandler(I2C_BusId bus)
+{
+	HAL_I2C_ER_IRQHandler(&buses[bus].hi2c);
+}
+
+void I2C_Bus_DMA_RxIRQHandler(I2C_BusId bus)
+{
+	HAL_DMA_IRQHandler(&buses[bus].hdma_rx);
+}
+
+void I2C_Bus_DMA_TxIRQHandler(I2C_BusId bus)
+{
+	HAL_DMA_IRQHandler(&buses[bus].hdma_tx);
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	I2C_Bus_Complete(hi2c, HAL_OK);
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	I2C_Bus_Complete(hi2c, HAL_OK);
+}
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	I2C_Bus_Complete(hi2c, HAL_OK);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+	I2C_Bus_Complete(hi2c, HAL_ERROR);
+}
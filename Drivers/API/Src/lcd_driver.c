@@ -9,66 +9,159 @@
 #include "lcd_driver.h"
 #include "lcd_port.h"
 #include "mpu6050_driver.h"
+#include "API_delay.h"
 #include "string.h"
 #include "stdio.h"
 
+/*
+ * Cada byte del PCF8574 ocupa 9 ciclos de SCL (~90 µs a 100 kHz), lo que ya cubre el ancho del pulso
+ * de ENABLE (450 ns) y el tiempo de ejecución de 37 µs entre caracteres del stream. El PCF8574 no
+ * admite más de 100 kHz, por lo que el bus del LCD no debe configurarse más rápido.
+ */
+#if I2C_BUS1_CLOCK_SPEED > 100000
+#error "El stream del LCD asume SCL <= 100 kHz (PCF8574)"
+#endif
+
 static I2C_LCD_Conf lcd_conf = {0};
+static const uint8_t row_offsets[LCD_MAX_ROWS] = {LCD_LINE_0, LCD_LINE_1, LCD_LINE_2, LCD_LINE_3};
+
+// Copia de la DDRAM visible y dirección actual del cursor del controlador
+static char lcd_shadow[LCD_MAX_ROWS][LCD_MAX_COLS];
+static uint8_t lcd_addr = 0;
+
+// Stream de bytes del PCF8574 pendiente de enviar
+static uint8_t lcd_stream[LCD_STREAM_SIZE];
+static uint16_t lcd_stream_len = 0;
+
+// Renderizado en segundo plano: último snapshot recibido y estado del cuadro en vuelo
+static LCD_SensorSnapshot render_snapshot;
+static volatile bool_t render_pending = false;
+static volatile bool_t render_busy = false;
+static volatile bool_t render_failed = false;
 
 static void LCD_Init();
-static void LCD_SendData(uint8_t data);
 static void LCD_SendCommand(uint8_t cmd);
 static void LCD_SendNibble( uint8_t nibble, uint8_t mode);
+static void LCD_StreamNibble(uint8_t nibble, uint8_t mode);
+static void LCD_StreamByte(uint8_t value, uint8_t mode);
+static void LCD_StreamFlush(void);
 static void FormatIntDecimal(char *buf, int32_t value, uint8_t decimal);
 static void LCD_PrintLine(uint8_t row, char* text);
+static void LCD_ShadowReset(void);
+static void LCD_ShadowStore(uint8_t data);
+static void LCD_WriteRowDiff(uint8_t row, const char *text);
+static void LCD_BuildSensorFrame(const LCD_SensorSnapshot *snapshot);
+static void LCD_RenderComplete(HAL_StatusTypeDef status, void *context);
 
 /**
- * @brief Envía un nibble (4 bits) al LCD a través de la interfaz I2C.
+ * @brief Codifica un nibble (4 bits) como bytes del PCF8574 y lo agrega al stream pendiente.
  *
  * Esta función está diseñada para trabajar con pantallas LCD que utilizan un expansor de bus I2C
  * (como el PCF8574) para comunicarse con el microcontrolador. El LCD opera en modo de 4 bits, por lo que
- * los datos deben enviarse en dos partes (nibbles altos y bajos). Esta función se encarga de enviar
- * un solo nibble, especificando si se trata de un comando o de datos.
+ * los datos deben enviarse en dos partes (nibbles altos y bajos). En lugar de escribir cada estado del
+ * expansor en una transacción I2C propia, los estados se acumulan en `lcd_stream`.
  *
- * @param nibble El valor de 4 bits que se desea enviar (generalmente parte de un byte completo).
+ * @param nibble El valor de 4 bits que se desea enviar, en los bits altos del byte.
  * @param mode   Indica si el nibble es un comando o datos:
- *               - 0 para comandos (RS = 0)
- *               - LCD_RS para datos (RS = 1), siendo LCD_RS una máscara que activa el bit correspondiente.
+ *               - `MODE_RS_IR` para comandos (RS = 0)
+ *               - `MODE_RS_DR` para datos (RS = 1)
  *
  * @details
  * 1. Combina el nibble con la retroiluminación (LCD_BACKLIGHT) y el modo (RS).
- * 2. Activa la señal de ENABLE en alto para latch del dato.
- * 3. Espera 5 ms para asegurar que el LCD procese el nibble (puede ser reducido dependiendo del LCD usado).
- * 4. Desactiva ENABLE para completar el ciclo de escritura.
+ * 2. Agrega el estado con ENABLE en alto y luego el mismo estado con ENABLE en bajo;
+ *    el flanco de bajada es el que captura el nibble.
+ * 3. La duración de cada byte en el bus I2C provee el ancho de pulso de ENABLE, sin retardos por software.
+ * 4. Si el stream está lleno se envía antes de agregar el nibble.
  *
  * @note
- * - Esta función es utilizada internamente por funciones de más alto nivel que manejan el envío de bytes completos.
- * - Asegúrese que el periférico I2C esté correctamente inicializado antes de utilizar esta función.
- * - La constante MASK debe asegurar que solo los bits relacionados al nibble y líneas de control estén activos.
+ * - Al comenzar un stream nuevo se espera a que termine el cuadro que el renderizador pueda
+ *   tener en vuelo, ya que el DMA todavía lee de `lcd_stream`.
  */
 
-static void LCD_SendNibble(uint8_t nibble, uint8_t mode)
+static void LCD_StreamNibble(uint8_t nibble, uint8_t mode)
 {
 	uint8_t data = (nibble & MASK) | LCD_BACKLIGHT | mode;
-	LCD_PortI2C_WriteRegister(data | ENABLE);
-    HAL_Delay(5);
-    LCD_PortI2C_WriteRegister(data & ~ENABLE);
+
+	if (lcd_stream_len == 0) {
+		while (render_busy) {
+		}
+	}
+	if (lcd_stream_len + LCD_STREAM_BYTES_PER_NIBBLE > LCD_STREAM_SIZE) LCD_StreamFlush();
+
+	lcd_stream[lcd_stream_len++] = data | ENABLE;
+	lcd_stream[lcd_stream_len++] = data & ~ENABLE;
+}
+
+/**
+ * @brief Codifica un byte completo (comando o carácter) en el stream pendiente.
+ *
+ * @param value Comando o carácter de 8 bits.
+ * @param mode  `MODE_RS_IR` para comandos o `MODE_RS_DR` para datos.
+ *
+ * @details
+ * 1. Se agrega primero el nibble más significativo y luego el menos significativo,
+ *    desplazado 4 bits a la izquierda.
+ * 2. Si es un dato, se actualiza el framebuffer sombra en el momento de codificarlo.
+ *
+ * @note
+ * - Los comandos lentos (clear / home) no deben codificarse en medio de un stream: necesitan
+ *   `LCD_T_EXEC_LONG_US` de espera, por lo que se envían con `LCD_SendCommand`.
+ */
+
+static void LCD_StreamByte(uint8_t value, uint8_t mode)
+{
+	LCD_StreamNibble(value, mode);
+	LCD_StreamNibble((value << 4) & MASK, mode);
+	if (mode == MODE_RS_DR) LCD_ShadowStore(value);
+}
+
+/**
+ * @brief Envía el stream pendiente en una única transacción I2C.
+ *
+ * Si no hay bytes pendientes no genera tráfico. Una actualización completa de la pantalla
+ * (4 filas de 20 caracteres más sus comandos de posición) cabe en `LCD_STREAM_SIZE` bytes,
+ * es decir, en una sola transacción en lugar de una por cada estado del PCF8574.
+ */
+
+static void LCD_StreamFlush(void)
+{
+	if (lcd_stream_len == 0) return;
+
+	LCD_PortI2C_WriteStream(lcd_stream, lcd_stream_len);
+	lcd_stream_len = 0;
+}
+
+/**
+ * @brief Envía un nibble aislado al LCD.
+ *
+ * Se usa solo durante la secuencia de inicialización, donde cada "function set" en 8 bits debe
+ * ir seguido de un retardo propio.
+ *
+ * @param nibble El valor de 4 bits que se desea enviar, en los bits altos del byte.
+ * @param mode   `MODE_RS_IR` o `MODE_RS_DR`.
+ */
+
+static void LCD_SendNibble(uint8_t nibble, uint8_t mode)
+{
+	LCD_StreamNibble(nibble, mode);
+	LCD_StreamFlush();
 }
 
 /**
  * @brief Envía un comando de 8 bits al LCD usando interfaz de 4 bits por I2C.
  *
- * Esta función divide un byte de comando en dos nibbles (alto y bajo) y los envía secuencialmente
- * al LCD usando la función auxiliar LCD_SendNibble. El comando puede incluir instrucciones como
- * limpiar la pantalla, mover el cursor, cambiar el modo de entrada, etc.
+ * Esta función divide un byte de comando en dos nibbles (alto y bajo) y los envía
+ * al LCD junto con cualquier contenido pendiente del stream, en una sola transacción.
+ * El comando puede incluir instrucciones como limpiar la pantalla, mover el cursor,
+ * cambiar el modo de entrada, etc.
  *
  * @param cmd Comando de 8 bits a enviar al LCD.
  *
  * @details
- * 1. En el modo de 4 bits, los comandos se envían en dos partes:
- *    - Primero se envía el nibble más significativo (MSB).
- *    - Luego se envía el nibble menos significativo (LSB), desplazado 4 bits a la izquierda.
- * 2. Ambos nibbles se envían en modo "Instrucción/Comando" (RS = 0), indicado por `MODE_RS_IR`.
- * 3. Se realiza un retardo breve de 2 ms tras enviar el comando, para asegurar que el LCD tenga tiempo suficiente para procesarlo.
+ * 1. El comando se codifica con `LCD_StreamByte` en modo "Instrucción/Comando" (RS = 0).
+ * 2. El stream se envía inmediatamente. Los 37 µs de ejecución quedan cubiertos por el
+ *    inicio de la transacción siguiente (START + dirección ≈ 100 µs a 100 kHz).
+ * 3. Los comandos lentos (clear / home) agregan su propia espera de `LCD_T_EXEC_LONG_US`.
  *
  * @note
  * - Esta función debe utilizarse para inicializar o controlar el comportamiento del LCD.
@@ -77,36 +170,98 @@ static void LCD_SendNibble(uint8_t nibble, uint8_t mode)
 
 static void LCD_SendCommand( uint8_t cmd)
 {
-	LCD_SendNibble( cmd, MODE_RS_IR);
-	LCD_SendNibble((cmd << 4), MODE_RS_IR );
-	HAL_Delay(2);
+	LCD_StreamByte(cmd, MODE_RS_IR);
+	LCD_StreamFlush();
+}
+
+/**
+ * @brief Restablece el framebuffer sombra al contenido de un display recién borrado.
+ *
+ * Tras `LCD_CLEARDISPLAY` el controlador llena la DDRAM con espacios y vuelve la dirección a 0,
+ * por lo que la copia sombra se llena con `' '` y el cursor se ubica en `0x00`.
+ */
+
+static void LCD_ShadowReset(void)
+{
+	memset(lcd_shadow, ' ', sizeof(lcd_shadow));
+	lcd_addr = 0;
 }
 
 /**
- * @brief Envía un dato (carácter) de 8 bits al LCD.
+ * @brief Registra en el framebuffer sombra el carácter escrito en la posición actual del cursor.
  *
- * Esta función permite mostrar caracteres en el LCD, enviando un byte de datos que representa
- * un carácter ASCII o similar. El byte se divide en dos nibbles y se envía mediante la función
- * `LCD_SendNibble` en modo de datos (RS = 1).
+ * @param data Carácter recién enviado al LCD.
+ *
+ * @details
+ * 1. Si la dirección DDRAM actual corresponde a una celda visible, se actualiza esa celda.
+ * 2. Se avanza la dirección como lo hace el HD44780 en modo incremento y 2 líneas:
+ *    `0x27 → 0x40` y `0x67 → 0x00`. Así, por ejemplo, la fila 0 continúa en la fila 2 en un 20x4.
+ */
+
+static void LCD_ShadowStore(uint8_t data)
+{
+	for (uint8_t row = 0; row < lcd_conf.I2C_LCD_nRow; row++)
+	{
+		if (lcd_addr >= row_offsets[row] && lcd_addr < row_offsets[row] + lcd_conf.I2C_LCD_nCol)
+		{
+			lcd_shadow[row][lcd_addr - row_offsets[row]] = (char)data;
+			break;
+		}
+	}
+
+	lcd_addr++;
+	if (lcd_addr == LCD_DDRAM_LINE0_END) lcd_addr = LCD_LINE_1;
+	else if (lcd_addr == LCD_DDRAM_LINE1_END) lcd_addr = LCD_LINE_0;
+}
+
+/**
+ * @brief Escribe una fila completa enviando solo los tramos que difieren del framebuffer sombra.
  *
- * @param data Byte de datos a mostrar en el LCD (por ejemplo, un carácter ASCII).
+ * @param row  Fila a actualizar.
+ * @param text Contenido deseado de la fila, exactamente `lcd_conf.I2C_LCD_nCol` caracteres.
  *
  * @details
- * 1. Se divide el byte en dos partes de 4 bits (nibble alto y nibble bajo).
- * 2. Cada nibble se envía individualmente, en modo de datos (`MODE_RS_DR`).
- * 3. El segundo nibble (parte baja) es enmascarado con `MASK` para evitar afectar otras líneas de control.
- * 4. Se aplica un pequeño retardo de 1 ms para garantizar que el LCD procese correctamente el carácter.
+ * 1. Se recorre la fila comparando `text` con `lcd_shadow[row]`.
+ * 2. Cada tramo sucio se extiende mientras los huecos sin cambios no superen `LCD_DIFF_MAX_GAP`
+ *    celdas: reescribir un carácter cuesta lo mismo que un nuevo comando `LCD_SETDDRAMADDR`.
+ * 3. Solo se codifica `LCD_SETDDRAMADDR` si el cursor no está ya en el inicio del tramo.
+ * 4. Se codifican los caracteres del tramo, que actualizan la copia sombra vía `LCD_StreamByte`.
  *
  * @note
- * - Asegurarse que el LCD esté en modo 4 bits y correctamente inicializado antes de enviar datos.
- * - Esta función debe usarse para imprimir texto carácter por carácter.
+ * - La fila solo se codifica en el stream; el envío lo hace quien llama con `LCD_StreamFlush()`.
+ * - Si la fila no cambió no se genera tráfico I2C.
  */
 
-static void LCD_SendData(uint8_t data)
+static void LCD_WriteRowDiff(uint8_t row, const char *text)
 {
-	LCD_SendNibble( data, MODE_RS_DR);
-	LCD_SendNibble((data << 4) & MASK, MODE_RS_DR );
-	HAL_Delay(1);
+	uint8_t col = 0;
+
+	while (col < lcd_conf.I2C_LCD_nCol)
+	{
+		if (lcd_shadow[row][col] == text[col])
+		{
+			col++;
+			continue;
+		}
+
+		uint8_t start = col;
+		uint8_t last_dirty = col;
+		for (uint8_t i = col + 1; i < lcd_conf.I2C_LCD_nCol; i++)
+		{
+			if (lcd_shadow[row][i] != text[i]) last_dirty = i;
+			else if (i - last_dirty > LCD_DIFF_MAX_GAP) break;
+		}
+
+		if (lcd_addr != row_offsets[row] + start)
+		{
+			lcd_addr = row_offsets[row] + start;
+			LCD_StreamByte(LCD_SETDDRAMADDR | lcd_addr, MODE_RS_IR);
+		}
+		for (col = start; col <= last_dirty; col++)
+		{
+			LCD_StreamByte((uint8_t)text[col], MODE_RS_DR);
+		}
+	}
 }
 
 /**
@@ -170,10 +325,9 @@ static void FormatIntDecimal(char *buf, int32_t value, uint8_t decimals)
  * @details
  * 1. Se copia el texto a un buffer temporal `buf` cuyo tamaño es el número de columnas del LCD (`lcd_conf.I2C_LCD_nCol`) + 1 (para el `'\0'`).
  * 2. Si el texto es más largo que las columnas disponibles, se trunca a `lcd_conf.I2C_LCD_nCol` caracteres.
- *    (⚠️ El código tiene un límite fijo de 20, lo cual podría corregirse si `lcd_conf.I2C_LCD_nCol` es menor a 20).
  * 3. Se rellenan los espacios sobrantes con `' '` (espacio) para borrar caracteres anteriores si el texto nuevo es más corto.
- * 4. Se posiciona el cursor en el inicio de la fila con `LCD_SetCursor`.
- * 5. Finalmente, se imprime el texto formateado mediante `LCD_SendString`.
+ * 4. Se compara la línea con el framebuffer sombra mediante `LCD_WriteRowDiff`, que codifica en el stream
+ *    el posicionamiento del cursor y solo las celdas que cambiaron. El envío queda a cargo de quien llama.
  *
  * @note
  * - Asegurate de que la función `LCD_SetCursor` esté correctamente implementada para posicionar por fila y columna.
@@ -190,7 +344,7 @@ static void LCD_PrintLine(uint8_t row, char* text)
 	char buf [lcd_conf.I2C_LCD_nCol + 1];
 	size_t len = strlen(text);
 
-	if(len > lcd_conf.I2C_LCD_nCol) len = 20 ;
+	if(len > lcd_conf.I2C_LCD_nCol) len = lcd_conf.I2C_LCD_nCol;
 	strncpy(buf, text, len);
 
 	for(size_t i = len; i < lcd_conf.I2C_LCD_nCol ; i++)
@@ -199,39 +353,36 @@ static void LCD_PrintLine(uint8_t row, char* text)
 	}
 
 	buf[lcd_conf.I2C_LCD_nCol] = '\0';
-    LCD_SetCursor(0, row);
-    LCD_SendString(buf);
+	if(row >= lcd_conf.I2C_LCD_nRow) row = lcd_conf.I2C_LCD_nRow - 1;
+	LCD_WriteRowDiff(row, buf);
 }
 
 /**
  * @brief Envía una cadena de texto al LCD carácter por carácter.
  *
- * Esta función recorre una cadena de caracteres terminada en nulo (`\0`) y envía cada carácter
- * individualmente al LCD usando `LCD_SendData`. Es útil para imprimir mensajes en pantalla
- * de forma sencilla y legible.
+ * Esta función recorre una cadena de caracteres terminada en nulo (`\0`), codifica todos sus
+ * caracteres en el stream del PCF8574 y la envía en una sola transacción I2C.
  *
  * @param str Puntero a la cadena de texto (tipo `char*`) que se desea mostrar en el LCD.
  *
  * @details
  * 1. Utiliza un bucle `while` que recorre la cadena hasta encontrar el carácter nulo (`\0`).
- * 2. Cada carácter es casteado a `uint8_t` y enviado al LCD usando `LCD_SendData`, que lo
- *    convierte internamente en nibbles y lo envía por I2C.
- * 3. Se aplica un retardo final de 2 ms después de enviar toda la cadena, lo cual da tiempo
- *    al LCD para completar la visualización (especialmente útil en pantallas lentas o al mostrar texto completo).
+ * 2. Cada carácter es casteado a `uint8_t` y codificado con `LCD_StreamByte` (4 bytes por carácter).
+ * 3. Se envía el stream completo con `LCD_StreamFlush()`. El tiempo de bus entre caracteres
+ *    ya respeta el tiempo de ejecución del controlador.
  *
  * @note
  * - La cadena no debe exceder el número de columnas disponibles en el LCD si se quiere evitar texto partido o líneas solapadas.
- * - Asegurate que `LCD_SendData` y `LCD_SetCursor` estén correctamente implementadas para que el texto se muestre donde corresponde.
+ * - Si la cadena supera `LCD_STREAM_SIZE` bytes codificados se envía en varias transacciones.
  *
  */
 
 void LCD_SendString(char *str) {
     while(*str) {
-    	LCD_SendData((uint8_t)(*str));
+    	LCD_StreamByte((uint8_t)(*str), MODE_RS_DR);
         str++;
     }
-
-    HAL_Delay(2);
+    LCD_StreamFlush();
 }
 
 /**
@@ -243,8 +394,8 @@ void LCD_SendString(char *str) {
  * @details
  * 1. El comando `LCD_CLEARDISPLAY` (generalmente `0x01`) es parte del conjunto de instrucciones del controlador HD44780.
  * 2. Este comando borra todos los caracteres del display y restablece la dirección del cursor.
- * 3. Se incluye un retardo de 2 ms posterior, ya que este comando es uno de los más lentos
- *    en ser procesados por el LCD y requiere tiempo adicional de espera.
+ * 3. Se espera `LCD_T_EXEC_LONG_US` (1.52 ms), ya que este comando es uno de los más lentos
+ *    en ser procesados por el LCD.
  *
  * @note
  * - Esta función debería usarse con moderación, ya que limpiar la pantalla frecuentemente puede causar parpadeos visibles.
@@ -254,7 +405,8 @@ void LCD_SendString(char *str) {
 
 void LCD_Clear() {
     LCD_SendCommand(LCD_CLEARDISPLAY);
-    HAL_Delay(2);
+    delayUs(LCD_T_EXEC_LONG_US);
+    LCD_ShadowReset();
 }
 
 /**
@@ -267,8 +419,8 @@ void LCD_Clear() {
  * 1. El comando `LCD_RETURNHOME` (normalmente `0x02`) es parte del conjunto de instrucciones estándar
  *    del controlador HD44780 y similares.
  * 2. Este comando no borra el contenido del display, a diferencia de `LCD_Clear`.
- * 3. Se requiere un retardo de al menos 1.52 ms para permitir que el controlador lo procese correctamente.
- *    En esta implementación se da un margen de 2 ms.
+ * 3. Se requiere un retardo de al menos 1.52 ms para permitir que el controlador lo procese correctamente
+ *    (`LCD_T_EXEC_LONG_US`).
  *
  * @note
  * - Utilizar esta función cuando se quiera reubicar el cursor o reiniciar el desplazamiento de texto en pantalla.
@@ -279,7 +431,8 @@ void LCD_Clear() {
 void LCD_Home(void)
 {
     LCD_SendCommand(LCD_RETURNHOME);
-    HAL_Delay(2);
+    delayUs(LCD_T_EXEC_LONG_US);
+    lcd_addr = 0;
 }
 
 /**
@@ -299,6 +452,7 @@ void LCD_Home(void)
  *    - Línea 2: 0x14
  *    - Línea 3: 0x54
  *    Estas se definen como constantes (`LCD_LINE_0`, etc.) y se almacenan en `row_offsets`.
+ *    La dirección resultante se guarda en `lcd_addr` para mantener sincronizado el framebuffer sombra.
  *
  * 2. Se limita el valor de `row` y `col` a los máximos configurados en `lcd_conf` para evitar errores.
  * 3. Luego se calcula la dirección en DDRAM sumando la columna al offset de la fila y se envía con el
@@ -317,10 +471,10 @@ void LCD_Home(void)
 
 void LCD_SetCursor(uint8_t col, uint8_t row)
 {
-    const uint8_t row_offsets[] = {LCD_LINE_0, LCD_LINE_1, LCD_LINE_2, LCD_LINE_3};
     if(row >= lcd_conf.I2C_LCD_nRow) row = lcd_conf.I2C_LCD_nRow - 1;
     if(col >= lcd_conf.I2C_LCD_nCol) col = lcd_conf.I2C_LCD_nCol - 1;
-    LCD_SendCommand(LCD_SETDDRAMADDR | (col + row_offsets[row]));
+    lcd_addr = col + row_offsets[row];
+    LCD_SendCommand(LCD_SETDDRAMADDR | lcd_addr);
 }
 
 /**
@@ -366,30 +520,32 @@ void LCD_Print(char *str)
  * 4. Se apaga el display, se limpia, se configura el modo de entrada y finalmente se enciende.
  *
  * @note
- * - Es fundamental respetar los retardos (`HAL_Delay`) entre comandos, especialmente al inicio,
- *   ya que algunos LCDs pueden tardar en arrancar después del encendido.
+ * - Es fundamental respetar los retardos entre comandos, especialmente al inicio, ya que algunos LCDs
+ *   pueden tardar en arrancar después del encendido. Se usan los tiempos de la hoja de datos del HD44780
+ *   (> 40 ms tras alcanzar VCC los 2.7 V, > 4.1 ms y > 100 µs entre los "function set" de 8 bits).
  * - Esta función debe llamarse una sola vez al comenzar el programa, antes de enviar cualquier comando o texto.
  *
  */
 
 void LCD_Init()
 {
-    HAL_Delay(50);
+    HAL_Delay(LCD_T_POWER_ON_MS);
 
     LCD_SendNibble(FUNCTION_SET_8BIT, MODE_RS_IR);
-    HAL_Delay(5);
+    delayUs(LCD_T_INIT_8BIT_US);
     LCD_SendNibble(FUNCTION_SET_8BIT, MODE_RS_IR);
-    HAL_Delay(5);
+    delayUs(LCD_T_INIT_SHORT_US);
     LCD_SendNibble(FUNCTION_SET_8BIT, MODE_RS_IR);
-    HAL_Delay(1);
+    delayUs(LCD_T_EXEC_US);
 
     LCD_SendNibble(LCD_FUNCTIONSET, MODE_RS_IR);
-    HAL_Delay(1);
+    delayUs(LCD_T_EXEC_US);
 
     LCD_SendCommand(LCD_FUNCTIONSET | LCD_4BITMODE | LCD_2LINE | LCD_5x8DOTS);
     LCD_SendCommand(LCD_DISPLAYCONTROL | LCD_DISPLAYOFF | LCD_CURSOROFF | LCD_BLINKOFF);
     LCD_SendCommand(LCD_CLEARDISPLAY);
-    HAL_Delay(2);
+    delayUs(LCD_T_EXEC_LONG_US);
+    LCD_ShadowReset();
     LCD_SendCommand(LCD_ENTRYMODESET | LCD_ENTRYLEFT | LCD_ENTRYSHIFTDECREMENT);
     LCD_SendCommand(LCD_DISPLAYCONTROL | LCD_DISPLAYON | LCD_CURSOROFF | LCD_BLINKOFF);
 }
@@ -406,7 +562,9 @@ void LCD_Init()
  * @details
  * 1. Se almacenan las dimensiones proporcionadas en la estructura `lcd_conf`, que es utilizada internamente
  *    por funciones como `LCD_SetCursor` o `LCD_PrintLine` para controlar el formato de salida.
- * 2. Luego se invoca `LCD_Init()`, que ejecuta la secuencia estándar de inicialización del controlador HD44780 en modo 4 bits.
+ *    Se limitan a `LCD_MAX_COLS` x `LCD_MAX_ROWS`, el tamaño del framebuffer sombra.
+ * 2. Se habilita la base de tiempo de microsegundos (`delayUsInit()`) usada para los tiempos del HD44780.
+ * 3. Luego se invoca `LCD_Init()`, que ejecuta la secuencia estándar de inicialización del controlador HD44780 en modo 4 bits.
  *
  * @note
  * - Esta función debe ser llamada al inicio del programa antes de imprimir cualquier texto en el LCD.
@@ -417,59 +575,183 @@ void LCD_Init()
 
 void LCD_Begin(uint8_t cols, uint8_t row)
 {
-	lcd_conf.I2C_LCD_nCol = cols;
-	lcd_conf.I2C_LCD_nRow = row;
+	lcd_conf.I2C_LCD_nCol = (cols > LCD_MAX_COLS) ? LCD_MAX_COLS : cols;
+	lcd_conf.I2C_LCD_nRow = (row > LCD_MAX_ROWS) ? LCD_MAX_ROWS : row;
+	if (!delayUsInit()) Error_Handler();
 	LCD_Init();
 }
 
 /**
- * @brief Muestra datos de sensores (temperatura, giroscopio y acelerómetro) en el LCD.
+ * @brief Codifica en el stream el cuadro de datos de sensores (temperatura, giroscopio y acelerómetro).
  *
- * Esta función convierte los valores enteros escalados (x100) de tres sensores a formato decimal
- * y los presenta en tres líneas consecutivas del display. Cada valor es formateado y alineado dentro
- * de la línea correspondiente.
+ * Convierte los valores enteros escalados (x100) del snapshot a formato decimal y los codifica
+ * en tres líneas consecutivas del display. No envía nada: el envío lo hace quien llama,
+ * de forma bloqueante (`LCD_PrintSensorData`) o por DMA (`LCD_RenderProcess`).
  *
- * @param temp_x100 Valor de temperatura multiplicado por 100 (por ejemplo, 2534 representa 25.3 °C).
- * @param gx_x100   Valor del eje X del giroscopio, también multiplicado por 100 (en grados por segundo).
- * @param ax_x100   Valor del eje X del acelerómetro, multiplicado por 100 (en "g").
+ * @param snapshot Valores a mostrar.
  *
  * @details
  * 1. Usa `FormatIntDecimal()` para convertir los valores enteros a cadenas con formato decimal.
  *    - Temperatura con 1 decimal (`23.4`)
  *    - Giroscopio y acelerómetro con 2 decimales (`-12.34`)
  * 2. Construye cada línea de texto (`line`) con un encabezado descriptivo y el valor formateado.
- * 3. Muestra cada línea en el LCD utilizando `LCD_PrintLine()`, una para cada fila.
+ * 3. Codifica cada línea utilizando `LCD_PrintLine()`, una para cada fila. Gracias al framebuffer
+ *    sombra solo se codifican los caracteres que cambiaron respecto del cuadro anterior.
  *
  * @note
  * - Requiere que el LCD tenga al menos 3 líneas. Si el número de filas es menor, la última línea se sobrescribirá.
- * - Asegurate de que el buffer `line` tenga suficiente espacio para acomodar los textos formateados.
- *
- * @example
- * ```
- * LCD_Begin(20, 4);
- * LCD_PrintSensorData(2345, -1578, 980);
- * // Muestra:
- * // Temp: 23.4 C
- * // Gx: -15.78 deg/s
- * // Ax: 9.80 g
- * ```
  */
-void LCD_PrintSensorData(int16_t temp_x100, int16_t gx_x100, int16_t ax_x100) {
+
+static void LCD_BuildSensorFrame(const LCD_SensorSnapshot *snapshot)
+{
     char line[lcd_conf.I2C_LCD_nCol + 1 ];  // 20 caracteres + nulo
     char value[10];
 
     // Línea 1: Temperatura
-    FormatIntDecimal(value, temp_x100, 1); // 1 decimal
+    FormatIntDecimal(value, snapshot->temp_x100, 1); // 1 decimal
     sprintf(line, "Temp: %s C", value);
     LCD_PrintLine(0, line);
 
     // Línea 2: Gyro X
-    FormatIntDecimal(value, gx_x100, 2); // 2 decimales
+    FormatIntDecimal(value, snapshot->gx_x100, 2); // 2 decimales
     sprintf(line, "Gx: %s deg/s", value);
     LCD_PrintLine(1, line);
 
     // Línea 3: Accel X
-    FormatIntDecimal(value, ax_x100, 2);
+    FormatIntDecimal(value, snapshot->ax_x100, 2);
     sprintf(line, "Ax: %s g", value);
     LCD_PrintLine(2, line);
 }
+
+/**
+ * @brief Muestra datos de sensores (temperatura, giroscopio y acelerómetro) en el LCD.
+ *
+ * Versión bloqueante: codifica el cuadro con `LCD_BuildSensorFrame()` y lo envía en una
+ * única transacción I2C, esperando a que termine.
+ *
+ * @param temp_x100 Valor de temperatura multiplicado por 100 (por ejemplo, 2534 representa 25.3 °C).
+ * @param gx_x100   Valor del eje X del giroscopio, también multiplicado por 100 (en grados por segundo).
+ * @param ax_x100   Valor del eje X del acelerómetro, multiplicado por 100 (en "g").
+ *
+ * @note
+ * - Para no bloquear el lazo principal usar `LCD_SubmitSensorData()` y `LCD_RenderProcess()`.
+ *
+ * @example
+ * ```
+ * LCD_Begin(20, 4);
+ * LCD_PrintSensorData(2345, -1578, 98);
+ * // Muestra:
+ * // Temp: 23.4 C
+ * // Gx: -15.78 deg/s
+ * // Ax: 0.98 g
+ * ```
+ */
+void LCD_PrintSensorData(int16_t temp_x100, int32_t gx_x100, int32_t ax_x100) {
+    LCD_SensorSnapshot snapshot = { temp_x100, gx_x100, ax_x100 };
+
+    LCD_BuildSensorFrame(&snapshot);
+    LCD_StreamFlush();
+}
+
+/**
+ * @brief Entrega al renderizador un nuevo snapshot de valores a mostrar, sin esperar al LCD.
+ *
+ * @param snapshot Valores a mostrar. Se copian, el llamador puede reutilizar la estructura.
+ *
+ * @details
+ * - Si todavía había un snapshot sin dibujar, se reemplaza: solo se dibuja el más reciente.
+ * - Puede llamarse desde el lazo principal o desde una interrupción.
+ *
+ * @example
+ * ```c
+ * LCD_SensorSnapshot snap = { temp, gyro.x, accel.x };
+ * LCD_SubmitSensorData(&snap);
+ * LCD_RenderProcess();
+ * ```
+ */
+
+void LCD_SubmitSensorData(const LCD_SensorSnapshot *snapshot)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	render_snapshot = *snapshot;
+	render_pending = true;
+	__set_PRIMASK(primask);
+}
+
+/**
+ * @brief Tarea de renderizado: dibuja el último snapshot por DMA si el LCD está libre.
+ *
+ * Debe llamarse periódicamente desde el lazo principal. Nunca espera a la transferencia I2C.
+ *
+ * @details
+ * 1. Si hay un cuadro en vuelo retorna inmediatamente; el snapshot pendiente se dibujará en
+ *    una llamada posterior (los snapshots intermedios se descartan).
+ * 2. Si el cuadro anterior falló, se invalida el framebuffer sombra para redibujar la pantalla completa.
+ * 3. Copia el snapshot pendiente, codifica el cuadro con `LCD_BuildSensorFrame()` y lo encola
+ *    en el bus con `LCD_PortI2C_WriteAsync()`.
+ * 4. Si el cuadro no cambió respecto al anterior no se genera tráfico I2C.
+ *
+ * @note
+ * - Si la cola del bus está llena, el stream se descarta y el snapshot queda pendiente para reintentar.
+ */
+
+void LCD_RenderProcess(void)
+{
+	LCD_SensorSnapshot snapshot;
+
+	if (render_busy || !render_pending) return;
+
+	if (render_failed)
+	{
+		// Contenido real desconocido: ninguna celda coincide y se fuerza el posicionamiento
+		memset(lcd_shadow, 0, sizeof(lcd_shadow));
+		lcd_addr = LCD_DDRAM_LINE1_END;
+		render_failed = false;
+	}
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	snapshot = render_snapshot;
+	render_pending = false;
+	__set_PRIMASK(primask);
+
+	LCD_BuildSensorFrame(&snapshot);
+	if (lcd_stream_len == 0) return;
+
+	render_busy = true;
+	if (!LCD_PortI2C_WriteAsync(lcd_stream, lcd_stream_len, LCD_RenderComplete, NULL))
+	{
+		render_busy = false;
+		render_failed = true;
+		render_pending = true;
+	}
+	lcd_stream_len = 0;
+}
+
+/**
+ * @brief Indica si el renderizador tiene un cuadro en vuelo.
+ *
+ * @return `true` mientras el DMA esté enviando el último cuadro.
+ */
+
+bool_t LCD_RenderIsBusy(void)
+{
+	return render_busy;
+}
+
+/*
+ * Fin del cuadro (contexto de interrupción). Un error deja el display en un estado desconocido,
+ * por lo que se marca para redibujar todo en el próximo cuadro.
+ */
+static void LCD_RenderComplete(HAL_StatusTypeDef status, void *context)
+{
+	(void)context;
+
+	if (status != HAL_OK)
+	{
+		render_failed = true;
+		render_pending = true;
+	}
+	render_busy = false;
+}
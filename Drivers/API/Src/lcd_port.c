@@ -7,36 +7,58 @@
 
 
 #include "lcd_port.h"
-#include "API_uart.h"
-
-static I2C_HandleTypeDef hi2c1;
+#include "API_log.h"
 
 void LCD_PortI2C_Init()
 {
-	  hi2c1.Instance = I2C1;
-	  hi2c1.Init.ClockSpeed = 100000;
-	  hi2c1.Init.DutyCycle = I2C_DUTYCYCLE_2;
-	  hi2c1.Init.OwnAddress1 = 0;
-	  hi2c1.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
-	  hi2c1.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
-	  hi2c1.Init.OwnAddress2 = 0;
-	  hi2c1.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
-	  hi2c1.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
-	  if (HAL_I2C_Init(&hi2c1) != HAL_OK)
-	  {
-	    Error_Handler();
-	  }
+	I2C_Bus_Init(LCD_I2C_BUS);
 }
 
 void LCD_PortI2C_Isready()
 {
-	if(HAL_I2C_IsDeviceReady(&hi2c1, LCD_ADDR, 1, HAL_MAX_DELAY) != HAL_OK) Error_Handler();
+	if(HAL_I2C_IsDeviceReady(I2C_Bus_GetHandle(LCD_I2C_BUS), LCD_ADDR, 1, HAL_MAX_DELAY) != HAL_OK) Error_Handler();
 }
 
 void LCD_PortI2C_WriteRegister(uint8_t valor)
 {
-	if(HAL_I2C_Master_Transmit(&hi2c1, LCD_ADDR, &valor, sizeof(valor), HAL_MAX_DELAY) != HAL_OK){
-		uartSendString((uint8_t*)"ERROR HANDLER LCD WRITE!\r\n");
+	I2C_Transaction xfer = {
+		.type = I2C_XFER_TRANSMIT,
+		.dev_addr = LCD_ADDR,
+		.data = &valor,
+		.size = sizeof(valor),
+	};
+
+	if(I2C_Bus_Transfer(LCD_I2C_BUS, &xfer) != HAL_OK){
+		LOG("ERROR HANDLER LCD WRITE! value=0x%02X", valor);
+		Error_Handler();
+	}
+}
+
+void LCD_PortI2C_WriteStream(uint8_t *data, uint16_t size)
+{
+	I2C_Transaction xfer = {
+		.type = I2C_XFER_TRANSMIT,
+		.dev_addr = LCD_ADDR,
+		.data = data,
+		.size = size,
+	};
+
+	if(I2C_Bus_Transfer(LCD_I2C_BUS, &xfer) != HAL_OK){
+		LOG("ERROR HANDLER LCD WRITE! stream=%u bytes", size);
 		Error_Handler();
 	}
 }
+
+bool_t LCD_PortI2C_WriteAsync(uint8_t *data, uint16_t size, I2C_XferCallback callback, void *context)
+{
+	I2C_Transaction xfer = {
+		.type = I2C_XFER_TRANSMIT,
+		.dev_addr = LCD_ADDR,
+		.data = data,
+		.size = size,
+		.callback = callback,
+		.context = context,
+	};
+
+	return I2C_Bus_Submit(LCD_I2C_BUS, &xfer);
+}
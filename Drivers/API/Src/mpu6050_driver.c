@@ -9,56 +9,522 @@
 #include "mpu6050_driver.h"
 #include "mpu6050_port.h"
 #include "API_uart.h"
+#include "API_log.h"
+#include "API_delay.h"
 
-static Vector3f gyro = {0}, accel = {0};
-static Vector3i16 gyroi16 = {0}, acceli16 = {0};
+#define SAMPLE_FIELD_TEMP  0x01
+#define SAMPLE_FIELD_GYRO  0x02
+#define SAMPLE_FIELD_ACCEL 0x04
+#define SAMPLE_FIELD_ALL   (SAMPLE_FIELD_TEMP | SAMPLE_FIELD_GYRO | SAMPLE_FIELD_ACCEL)
 
-static int16_t MPU6050_RawMeasurementRead(uint8_t address);
+// Registros y factores de escala de cada rango (MPU6050_DevConfigure)
+static const uint8_t gyro_fs_reg[] = { FS_GYRO_250, FS_GYRO_500, FS_GYRO_1000, FS_GYRO_2000 };
+static const float   gyro_fs_lsb[] = { FS_LSB_GYRO_250, FS_LSB_GYRO_500, FS_LSB_GYRO_1000, FS_LSB_GYRO_2000 };
+static const int32_t gyro_fs_q12[] = { Q12_GYRO_250_X100, Q12_GYRO_500_X100, Q12_GYRO_1000_X100, Q12_GYRO_2000_X100 };
+static const uint8_t acc_fs_reg[]  = { FS_ACC_2G, FS_ACC_4G, FS_ACC_8G, FS_ACC_16G };
+static const float   acc_fs_lsb[]  = { FS_LSB_ACC_250, FS_LSB_ACC_500, FS_LSB_ACC_1000, FS_LSB_ACC_2000 };
+static const int32_t acc_fs_q12[]  = { Q12_ACC_2G_X100, Q12_ACC_4G_X100, Q12_ACC_8G_X100, Q12_ACC_16G_X100 };
+
+// Sensor por defecto de la API de un solo sensor (I2C3, AD0 = 0, INT en MPU6050_INT_PIN)
+static mpu6050_dev_t mpu6050_default;
+
+static const MPU6050_RawSample *MPU6050_AcquireSample(mpu6050_dev_t *dev, uint8_t field);
+static void MPU6050_ParseBurst(const uint8_t *buf, MPU6050_RawSample *sample);
+static void MPU6050_AcquisitionComplete(HAL_StatusTypeDef status, void *context);
+static void MPU6050_DataReadyISR(void *context);
+static void MPU6050_FifoStatusComplete(HAL_StatusTypeDef status, void *context);
+static void MPU6050_FifoCountComplete(HAL_StatusTypeDef status, void *context);
+static void MPU6050_FifoDataComplete(HAL_StatusTypeDef status, void *context);
 // Float Measurements
-static float MPU6050_ReadTemperature();
-static Vector3f MPU6050_ReadGyroscope();
-static Vector3f MPU6050_ReadAccelerometer();
+static float MPU6050_ReadTemperature(mpu6050_dev_t *dev);
+static Vector3f MPU6050_ReadGyroscope(mpu6050_dev_t *dev);
+static Vector3f MPU6050_ReadAccelerometer(mpu6050_dev_t *dev);
 // Int Measurements
-static int16_t  MPU6050_ReadTemperatureInt();
-static Vector3i16 MPU6050_ReadGyroscopeInt();
-static Vector3i16 MPU6050_ReadAccelerometerInt();
+static int16_t  MPU6050_ReadTemperatureInt(mpu6050_dev_t *dev);
+static Vector3i32 MPU6050_ReadGyroscopeInt(mpu6050_dev_t *dev);
+static Vector3i32 MPU6050_ReadAccelerometerInt(mpu6050_dev_t *dev);
 
 /**
- * @brief Lee una medición cruda de 16 bits desde un registro del MPU6050.
- *
- * Esta función realiza la lectura de dos bytes consecutivos desde una dirección
- * del MPU6050 (por ejemplo, registros del acelerómetro, giroscopio o temperatura),
- * y reconstruye el valor como un entero con signo (`int16_t`).
+ * @brief Lee en una sola transacción I2C todas las mediciones del MPU6050.
  *
- * @param address Dirección del primer byte del dato de 16 bits a leer (ej., `MPU6050_REG_ACCEL_XOUT_H`).
+ * Esta función realiza una lectura en ráfaga de 14 bytes consecutivos a partir de `ACCEL_XOUT_H`
+ * (0x3B..0x48), que contienen acelerómetro, temperatura y giroscopio, y los reconstruye en una
+ * estructura `MPU6050_RawSample`. Todos los campos pertenecen al mismo instante de muestreo.
  *
- * @return Valor crudo de 16 bits con signo (int16_t), combinado de los dos bytes leídos.
+ * @param dev    Sensor a leer.
+ * @param sample Puntero a la estructura donde se almacena la muestra cruda. Puede ser `NULL`
+ *               si solo se desea refrescar la muestra interna usada por las funciones `Get*`.
  *
  * @details
- * 1. Se lee un bloque de dos bytes desde la dirección especificada usando la función
- *    `MPU6050_PortI2C_ReadRegister()`.
- * 2. Los bytes se combinan en formato big-endian: `buf[0]` es el byte más significativo (MSB),
- *    `buf[1]` el menos significativo (LSB).
- * 3. Se convierte el resultado a `int16_t`, ya que los datos del MPU6050 son firmados.
+ * 1. Se leen los 14 bytes con una única llamada a `MPU6050_PortI2C_ReadRegister()`,
+ *    en lugar de una transacción por eje (7 en total).
+ * 2. Los bytes se combinan en formato big-endian (`buf[0]` MSB, `buf[1]` LSB) para cada registro:
+ *    - `buf[0..5]`  → acelerómetro X, Y, Z
+ *    - `buf[6..7]`  → temperatura
+ *    - `buf[8..13]` → giroscopio X, Y, Z
+ * 3. La muestra se guarda también en la caché interna y se marcan todos sus campos como no leídos.
  *
  * @note
- * - Esta función es una base común para lecturas de aceleración, velocidad angular o temperatura.
+ * - A 100 kHz reduce el tiempo de bus por muestra aproximadamente 4 veces.
  * - Asegurarse de que el sensor esté correctamente inicializado antes de invocar esta función.
- * - Depende de la implementación correcta de `MPU6050_PortI2C_ReadRegister`.
  *
  * @example
  * ```c
- * int16_t ax = MPU6050_RawMeasurementRead(MPU6050_REG_ACCEL_XOUT_H);
- * int16_t gx = MPU6050_RawMeasurementRead(MPU6050_REG_GYRO_XOUT_H);
- * int16_t temp = MPU6050_RawMeasurementRead(MPU6050_REG_TEMP_OUT_H);
+ * MPU6050_RawSample s;
+ * MPU6050_ReadAll(&s);
+ * // s.accel.x, s.temp y s.gyro.x corresponden a la misma conversión
+ * ```
+ */
+
+void MPU6050_DevReadAll(mpu6050_dev_t *dev, MPU6050_RawSample *sample)
+{
+	uint8_t buf[MPU6050_BURST_LENGTH];
+	MPU6050_PortI2C_ReadRegister(&dev->i2c, ACCEL_XOUT_H, buf, MAX_BYTE_REGISTER, MPU6050_BURST_LENGTH);
+
+	MPU6050_ParseBurst(buf, &dev->sample_cache);
+	dev->sample_unread = SAMPLE_FIELD_ALL;
+
+	if (sample != NULL) *sample = dev->sample_cache;
+}
+
+/**
+ * @brief Reconstruye una muestra cruda a partir de los 14 bytes de la ráfaga `0x3B..0x48`.
+ *
+ * @param buf    Bytes leídos en formato big-endian (acelerómetro, temperatura, giroscopio).
+ * @param sample Estructura de salida.
+ */
+
+static void MPU6050_ParseBurst(const uint8_t *buf, MPU6050_RawSample *sample)
+{
+	for (int i = 0; i < 3; i++) {
+		((int16_t*)&sample->accel)[i] = (int16_t)((buf[2*i] << 8) | buf[2*i + 1]);
+		((int16_t*)&sample->gyro)[i]  = (int16_t)((buf[8 + 2*i] << 8) | buf[8 + 2*i + 1]);
+	}
+	sample->temp = (int16_t)((buf[6] << 8) | buf[7]);
+}
+
+/**
+ * @brief Inicia una lectura en ráfaga no bloqueante de todas las mediciones del MPU6050.
+ *
+ * Encola en el bus del sensor (I2C3 por defecto) una lectura DMA de los 14 bytes `0x3B..0x48` y retorna inmediatamente,
+ * de modo que la transferencia se solapa con el resto del lazo (por ejemplo, con la lectura SPI del BMP280).
+ * Puede llamarse desde interrupción (lo hace el manejador de dato listo).
+ *
+ * @return `true` si la lectura fue encolada, `false` si ya hay una en curso o la cola del bus está llena.
+ *
+ * @details
+ * Máquina de estados, análoga a la del BMP280:
+ * ```
+ * IDLE/READY/ERROR --Start--> BUSY --I2C OK--> READY --GetResult--> IDLE
+ *                                  --I2C error--> ERROR
+ * ```
+ * La marca de tiempo de la muestra (`delayGetMicros()`) se toma al encolar la lectura.
+ */
+
+bool_t MPU6050_DevStartAcquisition(mpu6050_dev_t *dev)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	if (dev->acq_state == MPU6050_ACQ_BUSY) {
+		__set_PRIMASK(primask);
+		return false;
+	}
+	dev->acq_state = MPU6050_ACQ_BUSY;
+	__set_PRIMASK(primask);
+
+	dev->acq_start_us = delayGetMicros();
+	if (!MPU6050_PortI2C_ReadRegisterAsync(&dev->i2c, ACCEL_XOUT_H, dev->acq_buf, MPU6050_BURST_LENGTH, MPU6050_AcquisitionComplete, dev)) {
+		dev->acq_state = MPU6050_ACQ_IDLE;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Devuelve el estado actual de la adquisición asíncrona.
+ *
+ * @return `MPU6050_ACQ_IDLE`, `MPU6050_ACQ_BUSY`, `MPU6050_ACQ_READY` o `MPU6050_ACQ_ERROR`.
+ */
+
+MPU6050_AcqState MPU6050_DevGetAcquisitionState(const mpu6050_dev_t *dev)
+{
+	return dev->acq_state;
+}
+
+/**
+ * @brief Obtiene la muestra de la última adquisición asíncrona.
+ *
+ * @param dev    Sensor a consultar.
+ * @param sample Estructura de salida. Puede ser `NULL` si solo se quiere actualizar la muestra
+ *               interna que usan las funciones `Get*`.
+ *
+ * @return `true` si había una muestra nueva sin consumir, `false` en caso contrario.
+ *
+ * @details
+ * La muestra pasa a la caché interna con todos sus campos marcados como no leídos, por lo que
+ * las siguientes llamadas a `MPU6050_Get*` la usan sin acceder al bus.
+ *
+ * @note
+ * - En modo dato listo la siguiente lectura puede estar ya en curso (`MPU6050_ACQ_BUSY`): la
+ *   muestra anterior se decodificó al terminar su transferencia y sigue disponible.
+ */
+
+bool_t MPU6050_DevGetAcquisitionResult(mpu6050_dev_t *dev, MPU6050_RawSample *sample)
+{
+	bool_t ready;
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	ready = dev->acq_sample_new;
+	if (ready) {
+		dev->sample_cache = dev->acq_sample;
+		dev->sample_timestamp_us = dev->acq_timestamp_us;
+		dev->acq_sample_new = false;
+	}
+	if (dev->acq_state == MPU6050_ACQ_READY || dev->acq_state == MPU6050_ACQ_ERROR) dev->acq_state = MPU6050_ACQ_IDLE;
+	__set_PRIMASK(primask);
+
+	if (!ready) return false;
+
+	dev->sample_unread = SAMPLE_FIELD_ALL;
+	if (sample != NULL) *sample = dev->sample_cache;
+	return true;
+}
+
+/**
+ * @brief Devuelve la marca de tiempo (µs, base `delayGetMicros()`) de la última muestra
+ *        entregada por `MPU6050_GetAcquisitionResult()`.
+ */
+
+uint32_t MPU6050_DevGetAcquisitionTimestamp(const mpu6050_dev_t *dev)
+{
+	return dev->sample_timestamp_us;
+}
+
+static void MPU6050_AcquisitionComplete(HAL_StatusTypeDef status, void *context)
+{
+	mpu6050_dev_t *dev = context;
+
+	if (status != HAL_OK) {
+		dev->acq_state = MPU6050_ACQ_ERROR;
+		return;
+	}
+
+	MPU6050_ParseBurst(dev->acq_buf, &dev->acq_sample);
+	dev->acq_timestamp_us = dev->acq_start_us;
+	dev->acq_sample_new = true;
+	dev->acq_state = MPU6050_ACQ_READY;
+
+	if (dev->dataready_callback != NULL) dev->dataready_callback(dev, &dev->acq_sample, dev->acq_timestamp_us);
+}
+
+/**
+ * @brief Habilita la adquisición por interrupción de dato listo del MPU6050.
+ *
+ * El sensor pulsa su pin INT (`dev->int_line`, `MPU6050_INT_PIN` para el sensor por defecto) cada vez que termina una conversión; el manejador
+ * EXTI toma la marca de tiempo y encola la lectura en ráfaga, sin consultas periódicas.
+ *
+ * @param dev      Sensor, con la línea INT asignada por `MPU6050_DevSetIntLine()`.
+ * @param callback Función llamada (en contexto de interrupción) con cada muestra y su marca de
+ *                 tiempo en µs. Puede ser `NULL` si la muestra se consume con `MPU6050_GetAcquisitionResult()`.
+ *
+ * @details
+ * 1. Se deshabilita la FIFO: ambos modos son excluyentes.
+ * 2. `INT_PIN_CFG`: INT activo en alto, push-pull, pulso de 50 µs; cualquier lectura limpia `INT_STATUS`.
+ * 3. `INT_ENABLE`: solo `DATA_RDY_EN`.
+ * 4. Se configura el pin como EXTI por flanco ascendente.
+ *
+ * @note
+ * - La tasa de interrupciones es `MPU6050_Config.sample_rate_hz` (1 kHz por defecto); cada ráfaga
+ *   ocupa ~0.4 ms del bus I2C3 a 400 kHz.
+ * - El MPU6050 no tiene interrupción por umbral de FIFO (solo desborde), por eso el modo por
+ *   interrupción usa dato listo y no la FIFO.
+ * - Si la lectura anterior no terminó cuando llega el siguiente pulso, la muestra se pierde y se
+ *   contabiliza en `MPU6050_DataReadyGetMissedCount()`.
+ */
+
+void MPU6050_DevDataReadyEnable(mpu6050_dev_t *dev, MPU6050_SampleCallback callback)
+{
+	if (dev->int_line.port == NULL) {
+		LOG("MPU6050 0x%02X WITHOUT INT LINE", dev->i2c.address);
+		Error_Handler();
+	}
+	MPU6050_DevFifoDisable(dev);
+	dev->dataready_callback = callback;
+	MPU6050_PortI2C_WriteRegister(&dev->i2c, INT_PIN_CFG, INT_PIN_CFG_RD_CLEAR, MAX_BYTE_REGISTER);
+	MPU6050_PortI2C_WriteRegister(&dev->i2c, INT_ENABLE, INT_DATA_RDY, MAX_BYTE_REGISTER);
+	MPU6050_PortINT_Init(&dev->int_line, MPU6050_DataReadyISR, dev);
+	dev->dataready_enabled = true;
+}
+
+/**
+ * @brief Deshabilita la interrupción de dato listo; el sensor vuelve a usarse por consulta.
+ */
+
+void MPU6050_DevDataReadyDisable(mpu6050_dev_t *dev)
+{
+	MPU6050_PortINT_Disable(&dev->int_line);
+	MPU6050_PortI2C_WriteRegister(&dev->i2c, INT_ENABLE, 0x00, MAX_BYTE_REGISTER);
+	while (dev->acq_state == MPU6050_ACQ_BUSY) {
+	}
+	dev->dataready_callback = NULL;
+	dev->dataready_enabled = false;
+}
+
+/**
+ * @brief Devuelve la cantidad de pulsos de dato listo descartados porque la lectura anterior seguía en curso.
+ */
+
+uint32_t MPU6050_DevDataReadyGetMissedCount(const mpu6050_dev_t *dev)
+{
+	return dev->dataready_missed;
+}
+
+static void MPU6050_DataReadyISR(void *context)
+{
+	mpu6050_dev_t *dev = context;
+
+	if (!MPU6050_DevStartAcquisition(dev)) dev->dataready_missed++;
+}
+
+/**
+ * @brief Habilita la FIFO del MPU6050 con acelerómetro, temperatura y giroscopio.
+ *
+ * A partir de esta llamada el sensor guarda cada muestra (a la tasa de `MPU6050_Config.sample_rate_hz`,
+ * 1 kHz por defecto) en su FIFO de 1024 bytes, de modo que el micro puede leerlas por lotes
+ * sin perder muestras entre consultas.
+ *
+ * @details
+ * 1. Se deshabilita el modo dato listo si estaba activo, y se deshabilita y se vacía la FIFO (`USER_CTRL.FIFO_RESET`).
+ * 2. Se seleccionan los sensores en `FIFO_EN`. El orden en la FIFO es el mismo que el de los
+ *    registros `0x3B..0x48`, por lo que cada cuadro tiene el formato de la ráfaga de 14 bytes.
+ * 3. Se habilita la interrupción de desborde (`INT_ENABLE`), necesaria para que `INT_STATUS` lo informe.
+ * 4. Se habilita la FIFO (`USER_CTRL.FIFO_EN`).
+ *
+ * @note
+ * - 1024 no es múltiplo de 14: tras un desborde la FIFO queda desalineada y debe reiniciarse.
+ *   `MPU6050_FifoStartDrain()` lo hace automáticamente.
+ * - A 1 kHz la FIFO se llena en ~73 ms, por lo que debe vaciarse a 20 Hz o más.
+ */
+
+void MPU6050_DevFifoEnable(mpu6050_dev_t *dev)
+{
+	if (dev->dataready_enabled) MPU6050_DevDataReadyDisable(dev);
+	MPU6050_PortI2C_WriteRegister(&dev->i2c, USER_CTRL, USER_CTRL_FIFO_RESET, MAX_BYTE_REGISTER);
+	MPU6050_PortI2C_WriteRegister(&dev->i2c, FIFO_EN, FIFO_EN_ALL, MAX_BYTE_REGISTER);
+	MPU6050_PortI2C_WriteRegister(&dev->i2c, INT_ENABLE, INT_FIFO_OFLOW, MAX_BYTE_REGISTER);
+	MPU6050_PortI2C_WriteRegister(&dev->i2c, USER_CTRL, USER_CTRL_FIFO_EN, MAX_BYTE_REGISTER);
+	dev->fifo_state = MPU6050_ACQ_IDLE;
+	dev->fifo_enabled = true;
+}
+
+/**
+ * @brief Deshabilita la FIFO; el sensor vuelve a usarse solo por consulta de registros.
+ */
+
+void MPU6050_DevFifoDisable(mpu6050_dev_t *dev)
+{
+	MPU6050_PortI2C_WriteRegister(&dev->i2c, USER_CTRL, 0x00, MAX_BYTE_REGISTER);
+	MPU6050_PortI2C_WriteRegister(&dev->i2c, FIFO_EN, 0x00, MAX_BYTE_REGISTER);
+	MPU6050_PortI2C_WriteRegister(&dev->i2c, INT_ENABLE, 0x00, MAX_BYTE_REGISTER);
+	dev->fifo_enabled = false;
+}
+
+/**
+ * @brief Inicia el vaciado no bloqueante de la FIFO.
+ *
+ * @return `true` si se encoló la primera transacción, `false` si ya hay un vaciado en curso
+ *         o la cola del bus está llena.
+ *
+ * @details
+ * La secuencia se encadena desde los callbacks del bus (contexto de interrupción):
+ * 1. Lectura de `INT_STATUS` (se borra al leerse) para detectar `FIFO_OFLOW_INT`.
+ * 2. Lectura de `FIFO_COUNTH/L`.
+ * 3. Si hubo desborde (o la FIFO está llena) se escribe `USER_CTRL` con `FIFO_RESET`: los datos
+ *    desalineados se descartan. Si no, se leen en una única ráfaga de `FIFO_R_W` todos los cuadros
+ *    completos disponibles (hasta `MPU6050_FIFO_MAX_FRAMES`); el resto queda para el próximo vaciado.
+ * 4. El estado pasa a `MPU6050_ACQ_READY` (o `MPU6050_ACQ_ERROR` si falló el bus).
+ */
+
+bool_t MPU6050_DevFifoStartDrain(mpu6050_dev_t *dev)
+{
+	if (dev->fifo_state == MPU6050_ACQ_BUSY) return false;
+
+	dev->fifo_state = MPU6050_ACQ_BUSY;
+	dev->fifo_frames = 0;
+	dev->fifo_overflow = false;
+	if (!MPU6050_PortI2C_ReadRegisterAsync(&dev->i2c, INT_STATUS, &dev->fifo_status, 1, MPU6050_FifoStatusComplete, dev)) {
+		dev->fifo_state = MPU6050_ACQ_IDLE;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Devuelve el estado del vaciado de la FIFO.
+ *
+ * @return `MPU6050_ACQ_IDLE`, `MPU6050_ACQ_BUSY`, `MPU6050_ACQ_READY` o `MPU6050_ACQ_ERROR`.
+ */
+
+MPU6050_AcqState MPU6050_DevFifoGetState(const mpu6050_dev_t *dev)
+{
+	return dev->fifo_state;
+}
+
+/**
+ * @brief Entrega el lote de muestras del último vaciado de la FIFO.
+ *
+ * @param dev      Sensor a consultar.
+ * @param samples  Arreglo de salida (en orden cronológico). Puede ser `NULL` si solo interesa
+ *                 la muestra más reciente a través de las funciones `Get*`.
+ * @param max      Capacidad de `samples`; si el lote es mayor se entregan las `max` más recientes.
+ * @param overflow Si no es `NULL`, indica si la FIFO desbordó (se perdieron muestras) antes de este vaciado.
+ *
+ * @return Cantidad de muestras escritas en `samples` (o del lote, si `samples` es `NULL`).
+ *         0 si el vaciado no terminó, falló o la FIFO estaba vacía.
+ *
+ * @details
+ * - La muestra más reciente se copia también a la caché interna, de modo que `MPU6050_Get*Int()`
+ *   devuelven ese instante sin una nueva lectura.
+ */
+
+uint16_t MPU6050_DevFifoGetBatch(mpu6050_dev_t *dev, MPU6050_RawSample *samples, uint16_t max, bool_t *overflow)
+{
+	if (overflow != NULL) *overflow = false;
+	if (dev->fifo_state != MPU6050_ACQ_READY) {
+		if (dev->fifo_state == MPU6050_ACQ_ERROR) dev->fifo_state = MPU6050_ACQ_IDLE;
+		return 0;
+	}
+
+	uint16_t frames = dev->fifo_frames;
+	if (overflow != NULL) *overflow = dev->fifo_overflow;
+
+	if (frames > 0) {
+		MPU6050_ParseBurst(&dev->fifo_buf[(frames - 1) * MPU6050_FIFO_FRAME_SIZE], &dev->sample_cache);
+		dev->sample_unread = SAMPLE_FIELD_ALL;
+	}
+
+	if (samples != NULL) {
+		uint16_t first = (frames > max) ? frames - max : 0;
+		for (uint16_t i = first; i < frames; i++) {
+			MPU6050_ParseBurst(&dev->fifo_buf[i * MPU6050_FIFO_FRAME_SIZE], &samples[i - first]);
+		}
+		frames -= first;
+	}
+
+	dev->fifo_state = MPU6050_ACQ_IDLE;
+	return frames;
+}
+
+/**
+ * @brief Vacía la FIFO de forma bloqueante y entrega el lote de muestras.
+ *
+ * Equivalente a `MPU6050_FifoStartDrain()` + espera + `MPU6050_FifoGetBatch()`.
+ *
+ * @example
+ * ```c
+ * static MPU6050_RawSample batch[MPU6050_FIFO_MAX_FRAMES];
+ * bool_t lost;
+ * uint16_t n = MPU6050_FifoRead(batch, MPU6050_FIFO_MAX_FRAMES, &lost);
  * ```
  */
 
-static int16_t MPU6050_RawMeasurementRead(uint8_t address)
+uint16_t MPU6050_DevFifoRead(mpu6050_dev_t *dev, MPU6050_RawSample *samples, uint16_t max, bool_t *overflow)
+{
+	while (!MPU6050_DevFifoStartDrain(dev)) {
+	}
+	while (dev->fifo_state == MPU6050_ACQ_BUSY) {
+	}
+	if (dev->fifo_state == MPU6050_ACQ_ERROR) {
+		LOG("ERROR HANDLER MPU6050 FIFO!");
+		Error_Handler();
+	}
+	return MPU6050_DevFifoGetBatch(dev, samples, max, overflow);
+}
+
+/**
+ * @brief Devuelve la cantidad de desbordes de la FIFO detectados desde el arranque.
+ */
+
+uint32_t MPU6050_DevFifoGetOverflowCount(const mpu6050_dev_t *dev)
+{
+	return dev->fifo_overflow_count;
+}
+
+static void MPU6050_FifoStatusComplete(HAL_StatusTypeDef status, void *context)
+{
+	mpu6050_dev_t *dev = context;
+
+	if (status != HAL_OK ||
+	    !MPU6050_PortI2C_ReadRegisterAsync(&dev->i2c, FIFO_COUNTH, dev->fifo_count_buf, sizeof(dev->fifo_count_buf), MPU6050_FifoCountComplete, dev)) {
+		dev->fifo_state = MPU6050_ACQ_ERROR;
+	}
+}
+
+static void MPU6050_FifoCountComplete(HAL_StatusTypeDef status, void *context)
+{
+	mpu6050_dev_t *dev = context;
+
+	if (status != HAL_OK) {
+		dev->fifo_state = MPU6050_ACQ_ERROR;
+		return;
+	}
+
+	uint16_t count = (uint16_t)((dev->fifo_count_buf[0] << 8) | dev->fifo_count_buf[1]);
+
+	if ((dev->fifo_status & INT_FIFO_OFLOW) || count >= MPU6050_FIFO_SIZE) {
+		dev->fifo_overflow = true;
+		dev->fifo_overflow_count++;
+		dev->fifo_ctrl = USER_CTRL_FIFO_EN | USER_CTRL_FIFO_RESET;
+		if (!MPU6050_PortI2C_WriteRegisterAsync(&dev->i2c, USER_CTRL, &dev->fifo_ctrl, MPU6050_FifoDataComplete, dev)) {
+			dev->fifo_state = MPU6050_ACQ_ERROR;
+		}
+		return;
+	}
+
+	dev->fifo_frames = count / MPU6050_FIFO_FRAME_SIZE;
+	if (dev->fifo_frames > MPU6050_FIFO_MAX_FRAMES) dev->fifo_frames = MPU6050_FIFO_MAX_FRAMES;
+	if (dev->fifo_frames == 0) {
+		dev->fifo_state = MPU6050_ACQ_READY;
+		return;
+	}
+
+	if (!MPU6050_PortI2C_ReadRegisterAsync(&dev->i2c, FIFO_R_W, dev->fifo_buf, dev->fifo_frames * MPU6050_FIFO_FRAME_SIZE, MPU6050_FifoDataComplete, dev)) {
+		dev->fifo_frames = 0;
+		dev->fifo_state = MPU6050_ACQ_ERROR;
+	}
+}
+
+static void MPU6050_FifoDataComplete(HAL_StatusTypeDef status, void *context)
+{
+	mpu6050_dev_t *dev = context;
+
+	if (status != HAL_OK) dev->fifo_frames = 0;
+	dev->fifo_state = (status == HAL_OK) ? MPU6050_ACQ_READY : MPU6050_ACQ_ERROR;
+}
+
+/**
+ * @brief Devuelve la muestra coherente actual, leyendo una nueva solo si el campo ya fue consumido.
+ *
+ * Las funciones `Get*` consultan un campo (temperatura, giroscopio o acelerómetro) de la misma
+ * muestra. Mientras ese campo no haya sido leído, se reutiliza la muestra en caché; cuando se vuelve
+ * a pedir un campo ya consumido se dispara una nueva ráfaga con `MPU6050_ReadAll()`.
+ *
+ * @param dev   Sensor.
+ * @param field Máscara del campo solicitado (`SAMPLE_FIELD_TEMP`, `SAMPLE_FIELD_GYRO` o `SAMPLE_FIELD_ACCEL`).
+ *
+ * @return Puntero a la muestra en caché.
+ *
+ * @note
+ * - Así la secuencia temperatura → giroscopio → acelerómetro del lazo principal cuesta una única
+ *   transacción I2C y los tres valores provienen del mismo instante.
+ */
+
+static const MPU6050_RawSample *MPU6050_AcquireSample(mpu6050_dev_t *dev, uint8_t field)
 {
-	uint8_t buf[LENGTH_DATA];
-	MPU6050_PortI2C_ReadRegister(address, buf, MAX_BYTE_REGISTER, LENGTH_DATA);
-	return (int16_t)((buf[0] << 8) | buf[1]);
+	if (!(dev->sample_unread & field)) MPU6050_DevReadAll(dev, NULL);
+	dev->sample_unread &= ~field;
+	return &dev->sample_cache;
 }
 
 // Int Measurements
@@ -73,14 +539,15 @@ static int16_t MPU6050_RawMeasurementRead(uint8_t address)
  *         Por ejemplo, un retorno de `2534` representa 25.34 °C.
  *
  * @details
- * 1. Se obtiene el valor crudo de 16 bits desde el registro `TEMP_OUT_H` usando `MPU6050_RawMeasurementRead()`.
+ * 1. Se obtiene el valor crudo de 16 bits de `TEMP_OUT_H` desde la muestra coherente (`MPU6050_AcquireSample()`).
  * 2. Se aplica la fórmula de conversión especificada por el fabricante:
  *    ```
  *    Temp(°C) = (raw / 340) + 36.53
  *    ```
- *    Al multiplicar por 100 para evitar el uso de `float`, se transforma a:
+ *    Al multiplicar por 100 para evitar el uso de `float`, y reemplazar la división por 340 por
+ *    una multiplicación y desplazamiento en Q12 (`100 / 340 * 4096 ≈ 1205`), se transforma a:
  *    ```
- *    Temp_x100 = ((raw * 100) / 340) + 3653
+ *    Temp_x100 = ((raw * 1205 + 2048) >> 12) + 3653
  *    ```
  * 3. El resultado final es un valor entero, ideal para visualización eficiente en sistemas embebidos.
  *
@@ -98,84 +565,85 @@ static int16_t MPU6050_RawMeasurementRead(uint8_t address)
  * ```
  */
 
-int16_t MPU6050_ReadTemperatureInt()
+static int16_t MPU6050_ReadTemperatureInt(mpu6050_dev_t *dev)
 {
-    int16_t raw = MPU6050_RawMeasurementRead(TEMP_OUT_H);
-    return ((raw * 100) / 340) + 3653;
+    int32_t raw = MPU6050_AcquireSample(dev, SAMPLE_FIELD_TEMP)->temp;
+    return (int16_t)(((raw * Q12_TEMP_X100 + MPU6050_Q_ROUND) >> MPU6050_Q_SHIFT) + TEMP_OFFSET_X100);
 }
 
 /**
  * @brief Lee los valores del giroscopio en los tres ejes y los convierte a °/s escalados por 100.
  *
- * Esta función accede a los registros crudos del giroscopio (X, Y, Z) del MPU6050, convierte cada valor
- * a grados por segundo usando la sensibilidad configurada (por defecto ±250 °/s), y los retorna
- * como un vector de enteros (`Vector3i16`) escalados por 100.
+ * Esta función toma los valores crudos del giroscopio (X, Y, Z) de la muestra coherente y los convierte
+ * a centésimas de grado por segundo con aritmética entera en punto fijo (sin FPU).
  *
- * @return Estructura `Vector3i16` con los valores del giroscopio en X, Y y Z, en centésimas de grado/segundo (°/s × 100).
+ * @return Estructura `Vector3i32` con los valores del giroscopio en X, Y y Z, en centésimas de grado/segundo (°/s × 100).
  *
  * @details
- * 1. El sensor entrega valores crudos de 16 bits por cada eje, desde registros consecutivos:
- *    - `GYRO_XOUT_H`, `GYRO_YOUT_H`, `GYRO_ZOUT_H`
- * 2. Se lee cada eje mediante `MPU6050_RawMeasurementRead()` sumando el desplazamiento de 2 bytes entre registros.
- * 3. Cada valor se escala usando la constante `FS_LSB_GYRO_250` (típicamente `131 LSB/(°/s)` para ±250°/s).
- *    La multiplicación por 100 permite representar el resultado como un entero (evitando `float`).
+ * 1. Los tres ejes se toman de la misma muestra en ráfaga (`MPU6050_AcquireSample()`), no de lecturas separadas.
+ * 2. Cada eje se escala con multiplicación y desplazamiento en Q12:
+ *    ```
+ *    gyro_x100 = (raw * gyro_q12 + 2048) >> 12
+ *    ```
+ *    donde la constante vale `round(100 / LSB_por_°/s * 4096)` para el rango activo
+ *    (por ejemplo `3127` para ±250 °/s, 131 LSB/(°/s)); la elige `MPU6050_Configure()`.
+ * 3. El intermedio es de 32 bits y el resultado también: a ±2000 °/s el valor x100 llega a ±200000,
+ *    que no entra en `int16_t`.
  *
  * @note
- * - Requiere que el sensor esté configurado previamente con el rango de ±250 °/s para que el factor sea correcto.
- * - Este formato es ideal para visualización, envío por UART o procesamiento sin FPU.
+ * - El error de la constante redondeada es menor a 0.02 % del fondo de escala.
  *
  * @example
  * ```c
- * Vector3i16 gyro = MPU6050_ReadGyroscopeInt();
+ * Vector3i32 gyro = MPU6050_ReadGyroscopeInt();
  * // Por ejemplo: gyro.x = -1234 → -12.34 °/s
  * ```
  */
 
-static Vector3i16 MPU6050_ReadGyroscopeInt()
+static Vector3i32 MPU6050_ReadGyroscopeInt(mpu6050_dev_t *dev)
 {
+    Vector3i32 gyroi32;
+    const MPU6050_RawSample *sample = MPU6050_AcquireSample(dev, SAMPLE_FIELD_GYRO);
     for (int i = 0; i < 3; i++) {
-        int16_t raw_gyro = MPU6050_RawMeasurementRead(GYRO_XOUT_H + 2*i);
-        ((int16_t*)&gyroi16)[i] = (raw_gyro * 100) / FS_LSB_GYRO_250;
+        int32_t raw_gyro = ((const int16_t*)&sample->gyro)[i];
+        ((int32_t*)&gyroi32)[i] = (raw_gyro * dev->gyro_q12 + MPU6050_Q_ROUND) >> MPU6050_Q_SHIFT;
     }
-    return gyroi16;
+    return gyroi32;
 }
 
 /**
  * @brief Lee los valores del acelerómetro en los tres ejes y los convierte a "g" escalados por 100.
  *
- * Esta función accede a los registros crudos del acelerómetro (X, Y, Z) del MPU6050, convierte cada valor
- * a unidades de aceleración gravitacional (`g`) y los devuelve en una estructura `Vector3i16`.
- * Los resultados están escalados por 100 para evitar el uso de punto flotante.
+ * Esta función toma los valores crudos del acelerómetro (X, Y, Z) de la muestra coherente y los convierte
+ * a centésimas de `g` con aritmética entera en punto fijo (sin FPU).
  *
- * @return Estructura `Vector3i16` con valores de aceleración en X, Y y Z, en centésimas de "g" (g × 100).
+ * @return Estructura `Vector3i32` con valores de aceleración en X, Y y Z, en centésimas de "g" (g × 100).
  *
  * @details
- * 1. El MPU6050 entrega valores crudos de 16 bits por cada eje desde registros consecutivos:
- *    - `ACCEL_XOUT_H`, `ACCEL_YOUT_H`, `ACCEL_ZOUT_H`
- * 2. Se accede a cada registro utilizando `MPU6050_RawMeasurementRead`, avanzando de 2 en 2 bytes.
- * 3. Cada valor se escala usando la constante `FS_LSB_GYRO_250`, aunque aquí parece haber un **error conceptual**:
- *    ⚠️ **Se debería usar `FS_LSB_ACCEL_2G`** (típicamente 16384 LSB/g) para el acelerómetro, no la constante del giroscopio.
- * 4. La multiplicación por 100 permite obtener una resolución de centésimas de g (`0.01g`), ideal para visualización y procesamiento sin `float`.
- *
- * @note
- * - Asegurarse de que el rango de medición del acelerómetro esté configurado en ±2g si se usa `FS_LSB_ACCEL_2G`.
- * - El uso de `FS_LSB_GYRO_250` en esta función es probablemente un error de copia/pega desde la función de giroscopio.
- *   Debería corregirse a la constante correspondiente del acelerómetro.
+ * 1. Los tres ejes se toman de la misma muestra en ráfaga obtenida con `MPU6050_AcquireSample()`.
+ * 2. Cada eje se escala con la constante Q12 del rango activo (`MPU6050_Configure()`):
+ *    ```
+ *    accel_x100 = (raw * acc_q12 + 2048) >> 12
+ *    ```
+ *    Las sensibilidades del acelerómetro son potencias de 2 (16384 LSB/g a ±2g), por lo que las
+ *    constantes (25, 50, 100, 200) son exactas.
  *
  * @example
  * ```c
- * Vector3i16 acc = MPU6050_ReadAccelerometerInt();
- * // Por ejemplo: acc.z = 980 → 9.80 g (aceleración vertical en reposo)
+ * Vector3i32 acc = MPU6050_ReadAccelerometerInt();
+ * // Por ejemplo: acc.z = 100 → 1.00 g (aceleración vertical en reposo)
  * ```
  */
 
-static Vector3i16 MPU6050_ReadAccelerometerInt()
+static Vector3i32 MPU6050_ReadAccelerometerInt(mpu6050_dev_t *dev)
 {
+    Vector3i32 acceli32;
+    const MPU6050_RawSample *sample = MPU6050_AcquireSample(dev, SAMPLE_FIELD_ACCEL);
     for (int i = 0; i < 3; i++) {
-        int16_t raw_accel = MPU6050_RawMeasurementRead(ACCEL_XOUT_H + 2*i);
-        ((int16_t*)&acceli16)[i] = (raw_accel * 100) / FS_LSB_ACC_250;
+        int32_t raw_accel = ((const int16_t*)&sample->accel)[i];
+        ((int32_t*)&acceli32)[i] = (raw_accel * dev->acc_q12 + MPU6050_Q_ROUND) >> MPU6050_Q_SHIFT;
     }
-    return acceli16;
+    return acceli32;
 }
 
 // Float Measurements
@@ -192,8 +660,7 @@ static Vector3i16 MPU6050_ReadAccelerometerInt()
  * 1. Se lee un valor crudo de 16 bits por cada eje desde los registros:
  *    - `ACCEL_XOUT_H`, `ACCEL_YOUT_H`, `ACCEL_ZOUT_H`
  * 2. Cada lectura se convierte directamente a `float`, dividiendo por el valor de sensibilidad en LSB/g.
- * 3. ⚠️ En esta función se está utilizando `FS_LSB_GYRO_250`, lo cual **no es correcto para el acelerómetro**.
- *    Debe usarse `FS_LSB_ACCEL_2G` (normalmente 16384 LSB/g para ±2g).
+ * 3. La sensibilidad corresponde al rango activo (16384 LSB/g para ±2g), elegido con `MPU6050_Configure()`.
  * 4. Los valores finales se almacenan en una estructura `Vector3f` (por ejemplo, con campos `.x`, `.y`, `.z`).
  *
  * @note
@@ -207,11 +674,13 @@ static Vector3i16 MPU6050_ReadAccelerometerInt()
  * ```
  */
 
-static Vector3f MPU6050_ReadAccelerometer()
+static Vector3f MPU6050_ReadAccelerometer(mpu6050_dev_t *dev)
 {
+    Vector3f accel;
+    const MPU6050_RawSample *sample = MPU6050_AcquireSample(dev, SAMPLE_FIELD_ACCEL);
     for (int i = 0; i < 3; i++) {
-        int16_t raw_accel = MPU6050_RawMeasurementRead(ACCEL_XOUT_H + 2*i);
-        ((float*)&accel)[i] = raw_accel / FS_LSB_ACC_250;
+        int16_t raw_accel = ((const int16_t*)&sample->accel)[i];
+        ((float*)&accel)[i] = raw_accel / dev->acc_lsb;
     }
     return accel;
 }
@@ -225,7 +694,7 @@ static Vector3f MPU6050_ReadAccelerometer()
  * @return Temperatura en grados Celsius como valor `float`.
  *
  * @details
- * 1. Se obtiene el valor crudo de 16 bits desde `TEMP_OUT_H` usando `MPU6050_RawMeasurementRead()`.
+ * 1. Se obtiene el valor crudo de 16 bits de `TEMP_OUT_H` desde la muestra coherente (`MPU6050_AcquireSample()`).
  * 2. Se aplica la fórmula oficial del fabricante:
  *    ```
  *    Temp(°C) = (raw / 340.0) + 36.53
@@ -244,9 +713,9 @@ static Vector3f MPU6050_ReadAccelerometer()
  * printf("Temperatura interna: %.2f °C\n", temp);
  * ```
  */
-static float MPU6050_ReadTemperature()
+static float MPU6050_ReadTemperature(mpu6050_dev_t *dev)
 {
-	int16_t raw_temprature = MPU6050_RawMeasurementRead(TEMP_OUT_H);
+	int16_t raw_temprature = MPU6050_AcquireSample(dev, SAMPLE_FIELD_TEMP)->temp;
 	return (raw_temprature / 340.0f) + 36.53f;
 }
 
@@ -265,8 +734,7 @@ static float MPU6050_ReadTemperature()
  * 3. Se almacena el resultado en una estructura `Vector3f` que contiene los tres ejes como `float`.
  *
  * @note
- * - La constante `FS_LSB_GYRO_250` debe coincidir con la configuración de rango del giroscopio.
- *   Si el rango cambia (por ejemplo, ±500 o ±1000 °/s), debe actualizarse la constante correspondiente.
+ * - La sensibilidad se toma del rango activo, el mismo que programó `MPU6050_Configure()`.
  * - Esta versión en `float` es ideal para algoritmos como filtros complementarios o de Kalman.
  *
  * @example
@@ -275,57 +743,178 @@ static float MPU6050_ReadTemperature()
  * printf("Giro X: %.2f °/s, Y: %.2f °/s, Z: %.2f °/s\n", g.x, g.y, g.z);
  * ```
  */
-static Vector3f MPU6050_ReadGyroscope()
+static Vector3f MPU6050_ReadGyroscope(mpu6050_dev_t *dev)
 {
+    Vector3f gyro;
+    const MPU6050_RawSample *sample = MPU6050_AcquireSample(dev, SAMPLE_FIELD_GYRO);
     for (int i = 0; i < 3; i++) {
-        int16_t raw_gyro = MPU6050_RawMeasurementRead(GYRO_XOUT_H + 2*i);
-        ((float*)&gyro)[i] = raw_gyro / FS_LSB_GYRO_250;
+        int16_t raw_gyro = ((const int16_t*)&sample->gyro)[i];
+        ((float*)&gyro)[i] = raw_gyro / dev->gyro_lsb;
     }
     return gyro;
 }
 
 
 /**
- * @brief Inicializa el sensor MPU6050 mediante interfaz I2C.
+ * @brief Inicializa un sensor MPU6050 en el bus y la dirección indicados.
  *
  * Esta función configura el MPU6050 para comenzar a tomar mediciones, estableciendo
  * los parámetros clave: encendido del dispositivo, divisor de muestreo, filtro DLPF,
  * y los rangos de medición tanto del giroscopio como del acelerómetro.
  *
+ * @param dev     Descriptor del sensor; debe permanecer válido mientras se use (normalmente `static`).
+ * @param bus     Bus I2C (`I2C_BUS_3` o `I2C_BUS_1`); se inicializa si todavía no lo estaba.
+ * @param address Dirección de 7 bits según el pin AD0: `MPU6050_ADDRESS_AD0_LOW` (0x68) o
+ *                `MPU6050_ADDRESS_AD0_HIGH` (0x69).
+ *
+ * @return `true` si el sensor respondió y quedó configurado, `false` si no fue detectado.
+ *
  * @details
- * 1. Verifica que el sensor esté conectado mediante `MPU6050_IsAvailable()`.
+ * 0. Se inicializa el descriptor: dirección, bus, estados `IDLE` y caché vacía. La línea INT no se
+ *    modifica; se asigna con `MPU6050_DevSetIntLine()`.
+ * 1. Verifica que el sensor esté conectado mediante `MPU6050_DevIsAvailable()`.
  *    Si no está disponible, la función finaliza inmediatamente.
- * 2. Escribe los siguientes registros con las configuraciones definidas:
- *    - `PWR_MGMT_1`: activa el sensor (sale de modo sleep).
- *    - `SMPLRT_DIV`: define el divisor de la tasa de muestreo.
- *    - `CONFIG`: configura el DLPF (Digital Low Pass Filter).
- *    - `GYRO_CONFIG`: establece el rango del giroscopio (por defecto ±250 °/s).
- *    - `ACCEL_CONFIG`: establece el rango del acelerómetro (por defecto ±2 g).
+ * 2. Escribe `PWR_MGMT_1` para activar el sensor (sale de modo sleep).
  * 3. Aplica un retardo de 100 ms tras encender el sensor para asegurar su estabilidad.
+ * 4. Aplica `MPU6050_CONFIG_DEFAULT` con `MPU6050_DevConfigure()`: ±250 °/s, ±2 g, DLPF de 44 Hz y 1 kHz.
  *
  * @note
  * - Esta función debe llamarse una vez al inicio del sistema antes de comenzar a leer datos.
- * - Las constantes como `CONF_PWR_MGMT`, `FS_GYRO_250` o `FS_ACC_2G` deben estar correctamente definidas
- *   según los valores esperados por el registro correspondiente del MPU6050.
- * - Se puede extender fácilmente para soportar configuración dinámica de rangos o filtros.
+ * - Para otro rango, filtro o tasa llamar luego a `MPU6050_DevConfigure()`.
+ * - Cada bus tiene su propia cola y su periférico: las transferencias de sensores en I2C1 e I2C3
+ *   se solapan, mientras que dos sensores en el mismo bus (0x68 y 0x69) se encolan uno tras otro.
+ *   I2C1 trabaja a 100 kHz (lo limita el LCD) y lee por interrupción, sin DMA de recepción.
  *
  * @example
  * ```c
- * MPU6050_Init();
- * Vector3f acc = MPU6050_ReadAccelerometer();
+ * static mpu6050_dev_t imu_a, imu_b;
+ * MPU6050_DevInit(&imu_a, I2C_BUS_3, MPU6050_ADDRESS_AD0_LOW);
+ * MPU6050_DevInit(&imu_b, I2C_BUS_3, MPU6050_ADDRESS_AD0_HIGH);
+ * // Tarea periódica: ambas ráfagas quedan encoladas en I2C3 sin esperar
+ * MPU6050_DevStartAcquisition(&imu_a);
+ * MPU6050_DevStartAcquisition(&imu_b);
  * ```
  */
 
-
-void MPU6050_Init()
+bool_t MPU6050_DevInit(mpu6050_dev_t *dev, I2C_BusId bus, uint8_t address)
 {
-	if(!MPU6050_IsAvailable()) return;
-	MPU6050_PortI2C_WriteRegister(PWR_MGMT_1, CONF_PWR_MGMT, MAX_BYTE_REGISTER);
+	MPU6050_Config config = MPU6050_CONFIG_DEFAULT;
+
+	dev->i2c.bus = bus;
+	dev->i2c.address = address;
+	dev->config = config;
+	dev->sample_unread = 0;
+	dev->acq_state = MPU6050_ACQ_IDLE;
+	dev->acq_sample_new = false;
+	dev->dataready_callback = NULL;
+	dev->dataready_enabled = false;
+	dev->dataready_missed = 0;
+	dev->fifo_state = MPU6050_ACQ_IDLE;
+	dev->fifo_enabled = false;
+	dev->fifo_overflow_count = 0;
+
+	MPU6050_PortI2C_Init(bus);
+	if(!MPU6050_DevIsAvailable(dev)) return false;
+	MPU6050_PortI2C_WriteRegister(&dev->i2c, PWR_MGMT_1, CONF_PWR_MGMT, MAX_BYTE_REGISTER);
 	HAL_Delay(100);
-	MPU6050_PortI2C_WriteRegister(SMPLRT_DIV, CONF_SMPLRT_DIV, MAX_BYTE_REGISTER);
-	MPU6050_PortI2C_WriteRegister(CONFIG, CONFIG_DLPF, MAX_BYTE_REGISTER);
-	MPU6050_PortI2C_WriteRegister(GYRO_CONFIG, FS_GYRO_250, MAX_BYTE_REGISTER);
-	MPU6050_PortI2C_WriteRegister(ACCEL_CONFIG, FS_ACC_2G, MAX_BYTE_REGISTER);
+
+	return MPU6050_DevConfigure(dev, &config);
+}
+
+/**
+ * @brief Asigna el pin EXTI conectado a la salida INT del sensor (modo dato listo).
+ *
+ * @param dev     Sensor.
+ * @param port    Puerto GPIO del pin.
+ * @param pin     Pin (`GPIO_PIN_x`); cada sensor necesita una línea EXTI distinta.
+ * @param irq     Interrupción de la línea (por ejemplo `EXTI9_5_IRQn`), cuyo manejador en
+ *                `stm32f4xx_it.c` debe llamar a `HAL_GPIO_EXTI_IRQHandler()` con ese pin.
+ */
+
+void MPU6050_DevSetIntLine(mpu6050_dev_t *dev, GPIO_TypeDef *port, uint16_t pin, IRQn_Type irq)
+{
+	dev->int_line.port = port;
+	dev->int_line.pin = pin;
+	dev->int_line.irq = irq;
+}
+
+/**
+ * @brief Aplica rango del giroscopio y del acelerómetro, filtro DLPF y tasa de muestreo.
+ *
+ * Permite elegir en tiempo de ejecución entre ruido y ancho de banda. Los factores de escala de las
+ * funciones `Get*` (enteras en Q12 y `float`) se cambian junto con los registros, de modo que las
+ * lecturas siguen expresadas en °/s, g y °C.
+ *
+ * @param dev    Sensor a configurar.
+ * @param config Configuración deseada.
+ *
+ * @return `false` si algún campo está fuera de rango (no se escribe nada), `true` en caso contrario.
+ *
+ * @details
+ * 1. La tasa de muestreo es `gyro_rate / (1 + SMPLRT_DIV)`, con `gyro_rate` de 8 kHz si el DLPF está
+ *    apagado (`MPU6050_DLPF_260HZ`) y de 1 kHz en otro caso. Se elige el divisor más cercano
+ *    (1..256) y la tasa obtenida queda en `MPU6050_GetConfig()`.
+ * 2. Se espera a que terminen la adquisición y el vaciado de la FIFO en curso; en modo dato listo se
+ *    enmascara el EXTI mientras se escriben `SMPLRT_DIV`, `CONFIG`, `GYRO_CONFIG` y `ACCEL_CONFIG`.
+ * 3. Se actualizan los factores de escala y se descartan las muestras en caché, tomadas con el rango anterior.
+ * 4. Si la FIFO está habilitada se vacía, para no mezclar cuadros de ambas configuraciones.
+ *
+ * @note
+ * - El acelerómetro muestrea a 1 kHz como máximo: por encima, los datos de aceleración se repiten.
+ *
+ * @example
+ * ```c
+ * MPU6050_Config cfg = MPU6050_CONFIG_DEFAULT;
+ * cfg.gyro_range = MPU6050_GYRO_2000DPS;
+ * cfg.dlpf = MPU6050_DLPF_94HZ;
+ * cfg.sample_rate_hz = 200;
+ * MPU6050_Configure(&cfg);
+ * ```
+ */
+
+bool_t MPU6050_DevConfigure(mpu6050_dev_t *dev, const MPU6050_Config *config)
+{
+	if (config == NULL || config->gyro_range > MPU6050_GYRO_2000DPS || config->acc_range > MPU6050_ACC_16G ||
+	    config->dlpf > MPU6050_DLPF_5HZ || config->sample_rate_hz == 0) return false;
+
+	uint32_t gyro_rate = (config->dlpf == MPU6050_DLPF_260HZ) ? MPU6050_GYRO_RATE_DLPF_OFF : MPU6050_GYRO_RATE_DLPF_ON;
+	uint32_t div = (gyro_rate + config->sample_rate_hz / 2) / config->sample_rate_hz;
+	if (div < 1) div = 1;
+	if (div > 256) div = 256;
+
+	if (dev->dataready_enabled) MPU6050_PortINT_Disable(&dev->int_line);
+	while (dev->acq_state == MPU6050_ACQ_BUSY || dev->fifo_state == MPU6050_ACQ_BUSY) {
+	}
+
+	MPU6050_PortI2C_WriteRegister(&dev->i2c, SMPLRT_DIV, (uint8_t)(div - 1), MAX_BYTE_REGISTER);
+	MPU6050_PortI2C_WriteRegister(&dev->i2c, CONFIG, (uint8_t)config->dlpf, MAX_BYTE_REGISTER);
+	MPU6050_PortI2C_WriteRegister(&dev->i2c, GYRO_CONFIG, gyro_fs_reg[config->gyro_range], MAX_BYTE_REGISTER);
+	MPU6050_PortI2C_WriteRegister(&dev->i2c, ACCEL_CONFIG, acc_fs_reg[config->acc_range], MAX_BYTE_REGISTER);
+
+	dev->config = *config;
+	dev->config.sample_rate_hz = (uint16_t)(gyro_rate / div);
+	dev->gyro_lsb = gyro_fs_lsb[config->gyro_range];
+	dev->gyro_q12 = gyro_fs_q12[config->gyro_range];
+	dev->acc_lsb = acc_fs_lsb[config->acc_range];
+	dev->acc_q12 = acc_fs_q12[config->acc_range];
+	dev->sample_unread = 0;
+	dev->acq_sample_new = false;
+
+	if (dev->fifo_enabled) {
+		MPU6050_PortI2C_WriteRegister(&dev->i2c, USER_CTRL, USER_CTRL_FIFO_EN | USER_CTRL_FIFO_RESET, MAX_BYTE_REGISTER);
+		dev->fifo_state = MPU6050_ACQ_IDLE;
+	}
+	if (dev->dataready_enabled) MPU6050_PortINT_Init(&dev->int_line, MPU6050_DataReadyISR, dev);
+	return true;
+}
+
+/**
+ * @brief Devuelve la configuración activa, con la tasa de muestreo efectivamente obtenida.
+ */
+
+void MPU6050_DevGetConfig(const mpu6050_dev_t *dev, MPU6050_Config *config)
+{
+	if (config != NULL) *config = dev->config;
 }
 
 /**
@@ -356,6 +945,16 @@ void MPU6050_Check()
 	MPU6050_Init();
 }
 
+/*
+ * API de un solo sensor: envolturas sobre el sensor por defecto (I2C3, AD0 = 0).
+ */
+
+void MPU6050_Init()
+{
+	MPU6050_DevSetIntLine(&mpu6050_default, MPU6050_INT_GPIO_PORT, MPU6050_INT_PIN, MPU6050_INT_IRQn);
+	MPU6050_DevInit(&mpu6050_default, MPU6050_I2C_BUS, MPU6050_ADDRESS_AD0_LOW);
+}
+
 // Int Measurements
 
 /**
@@ -385,18 +984,18 @@ void MPU6050_Check()
  * ```
  */
 
-int16_t MPU6050_GetTemperatureInt()
+int16_t MPU6050_DevGetTemperatureInt(mpu6050_dev_t *dev)
 {
-	return MPU6050_ReadTemperatureInt();
+	return MPU6050_ReadTemperatureInt(dev);
 }
 
 /**
  * @brief Obtiene los valores del giroscopio del MPU6050 en formato entero (°/s × 100).
  *
  * Esta función es un alias directo de `MPU6050_ReadGyroscopeInt()`, que lee los datos del giroscopio
- * en los tres ejes y los devuelve en una estructura `Vector3i16` con los valores escalados en centésimas de grado por segundo.
+ * en los tres ejes y los devuelve en una estructura `Vector3i32` con los valores escalados en centésimas de grado por segundo.
  *
- * @return Estructura `Vector3i16` con los valores de X, Y, Z del giroscopio (unidad: °/s × 100).
+ * @return Estructura `Vector3i32` con los valores de X, Y, Z del giroscopio (unidad: °/s × 100).
  *
  * @details
  * - Cada componente del vector representa el valor del giroscopio multiplicado por 100 para mantener precisión
@@ -406,18 +1005,18 @@ int16_t MPU6050_GetTemperatureInt()
  *
  * @note
  * - Asegurate de que el MPU6050 haya sido inicializado previamente con `MPU6050_Init()`.
- * - La escala depende de la constante `FS_LSB_GYRO_250`, que debe coincidir con la configuración actual del sensor.
+ * - La escala sigue al rango activo (`MPU6050_Configure()`).
  *
  * @example
  * ```c
- * Vector3i16 gyro = MPU6050_GetGyroscopeInt();
+ * Vector3i32 gyro = MPU6050_GetGyroscopeInt();
  * printf("Giro X: %d (%.2f °/s)\n", gyro.x, gyro.x / 100.0f);
  * ```
  */
 
-Vector3i16  MPU6050_GetGyroscopeInt()
+Vector3i32  MPU6050_DevGetGyroscopeInt(mpu6050_dev_t *dev)
 {
-	return MPU6050_ReadGyroscopeInt();
+	return MPU6050_ReadGyroscopeInt(dev);
 }
 
 /**
@@ -426,14 +1025,14 @@ Vector3i16  MPU6050_GetGyroscopeInt()
  * Esta función retorna los valores del acelerómetro en los tres ejes (X, Y, Z), escalados
  * como centésimas de "g", utilizando la función `MPU6050_ReadAccelerometerInt()`.
  *
- * @return Estructura `Vector3i16` con los valores de aceleración en X, Y y Z, en g × 100.
+ * @return Estructura `Vector3i32` con los valores de aceleración en X, Y y Z, en g × 100.
  *
  * @details
  * - Internamente llama a `MPU6050_ReadAccelerometerInt()`, que se encarga de:
  *   1. Leer los registros crudos del sensor (ACCEL_XOUT_H, etc.).
  *   2. Convertirlos a unidades de "g" multiplicadas por 100.
  * - Este formato es ideal para microcontroladores sin FPU o cuando se desea evitar `float`.
- * - Por ejemplo, un valor de `980` representa una aceleración de 9.80 g.
+ * - Por ejemplo, un valor de `98` representa una aceleración de 0.98 g.
  *
  * @note
  * - La escala usada debe coincidir con el rango de configuración del acelerómetro (ej. ±2g → 16384 LSB/g).
@@ -441,14 +1040,14 @@ Vector3i16  MPU6050_GetGyroscopeInt()
  *
  * @example
  * ```c
- * Vector3i16 acc = MPU6050_GetAccelerometerInt();
+ * Vector3i32 acc = MPU6050_GetAccelerometerInt();
  * printf("Acc X: %d (%.2f g)\n", acc.x, acc.x / 100.0f);
  * ```
  */
 
-Vector3i16  MPU6050_GetAccelerometerInt()
+Vector3i32  MPU6050_DevGetAccelerometerInt(mpu6050_dev_t *dev)
 {
-	return MPU6050_ReadAccelerometerInt();
+	return MPU6050_ReadAccelerometerInt(dev);
 }
 
 // Float Measurements
@@ -479,9 +1078,9 @@ Vector3i16  MPU6050_GetAccelerometerInt()
  */
 
 
-float MPU6050_GetTemperature()
+float MPU6050_DevGetTemperature(mpu6050_dev_t *dev)
 {
-	return  MPU6050_ReadTemperature();
+	return MPU6050_ReadTemperature(dev);
 }
 
 
@@ -502,7 +1101,7 @@ float MPU6050_GetTemperature()
  *
  * @note
  * - Asegurate de que el sensor esté correctamente inicializado y configurado con `MPU6050_Init()`.
- * - El valor de sensibilidad (`FS_LSB_GYRO_250`) debe coincidir con el rango activo del sensor.
+ * - El valor de sensibilidad se deriva del rango configurado con `MPU6050_Configure()`.
  *
  * @example
  * ```c
@@ -511,8 +1110,8 @@ float MPU6050_GetTemperature()
  * ```
  */
 
-Vector3f MPU6050_GetGyroscope() {
-    return MPU6050_ReadGyroscope();
+Vector3f MPU6050_DevGetGyroscope(mpu6050_dev_t *dev) {
+    return MPU6050_ReadGyroscope(dev);
 }
 
 /**
@@ -530,7 +1129,7 @@ Vector3f MPU6050_GetGyroscope() {
  * - La salida está en punto flotante, ideal para cálculos posteriores con filtros de actitud, controladores PID, etc.
  *
  * @note
- * - El valor de sensibilidad (`FS_LSB_ACCEL_2G`) debe coincidir con el rango configurado en el sensor.
+ * - El valor de sensibilidad se deriva del rango configurado con `MPU6050_Configure()`.
  * - Asegurate de inicializar el MPU6050 con `MPU6050_Init()` antes de usar esta función.
  *
  * @example
@@ -540,24 +1139,27 @@ Vector3f MPU6050_GetGyroscope() {
  * ```
  */
 
-Vector3f MPU6050_GetAccelerometer()
+Vector3f MPU6050_DevGetAccelerometer(mpu6050_dev_t *dev)
 {
-    return MPU6050_ReadAccelerometer();
+    return MPU6050_ReadAccelerometer(dev);
 }
 
 /**
  * @brief Verifica si el sensor MPU6050 está presente y responde correctamente por I2C.
  *
  * Esta función lee el registro de identificación (`WHO_AM_I`) del MPU6050 y compara el valor
- * con la dirección esperada (`ADDRESS_MPU6050`). Devuelve `true` si el sensor está disponible
+ * con el esperado (`MPU6050_WHO_AM_I_VALUE`). Devuelve `true` si el sensor está disponible
  * y responde correctamente, o `false` en caso contrario.
  *
+ * @param dev Sensor a verificar.
+ *
  * @return `true` si el sensor fue detectado correctamente, `false` si no hay respuesta o el ID no coincide.
  *
  * @details
  * 1. El registro `WHO_AM_I` (0x75) contiene un valor fijo que identifica al dispositivo (usualmente `0x68`).
  * 2. La función lee este registro usando la interfaz I2C con `MPU6050_PortI2C_ReadRegister()`.
- * 3. Compara el valor recibido con `ADDRESS_MPU6050` (debe estar definido como `0x68` o el valor real del sensor).
+ * 3. Compara el valor recibido con `MPU6050_WHO_AM_I_VALUE` (`0x68`). El registro no refleja el pin AD0,
+ *    por lo que un sensor en `0x69` también devuelve `0x68`.
  * 4. Si coinciden, devuelve `true`; en caso contrario, `false`.
  *
  * @note
@@ -566,16 +1168,136 @@ Vector3f MPU6050_GetAccelerometer()
  *
  * @example
  * ```c
- * if (!MPU6050_IsAvailable()) {
- *     uartSendString((uint8_t*)"MPU6050 no detectado\r\n");
+ * if (!MPU6050_DevIsAvailable(&imu)) {
+ *     LOG("MPU6050 no detectado");
  *     Error_Handler();
  * }
  * ```
  */
 
-bool_t MPU6050_IsAvailable()
+bool_t MPU6050_DevIsAvailable(mpu6050_dev_t *dev)
 {
 	uint8_t id_device = 0;
-	MPU6050_PortI2C_ReadRegister(WHO_AM_I, &id_device, MAX_BYTE_REGISTER, MAX_BYTE_SEND);
-	return id_device == ADDRESS_MPU6050;
+	MPU6050_PortI2C_ReadRegister(&dev->i2c, WHO_AM_I, &id_device, MAX_BYTE_REGISTER, MAX_BYTE_SEND);
+	return id_device == MPU6050_WHO_AM_I_VALUE;
+}
+
+bool_t MPU6050_IsAvailable()
+{
+	return MPU6050_DevIsAvailable(&mpu6050_default);
+}
+
+bool_t MPU6050_Configure(const MPU6050_Config *config)
+{
+	return MPU6050_DevConfigure(&mpu6050_default, config);
+}
+
+void MPU6050_GetConfig(MPU6050_Config *config)
+{
+	MPU6050_DevGetConfig(&mpu6050_default, config);
+}
+
+float MPU6050_GetTemperature()
+{
+	return MPU6050_DevGetTemperature(&mpu6050_default);
+}
+
+Vector3f MPU6050_GetGyroscope()
+{
+	return MPU6050_DevGetGyroscope(&mpu6050_default);
+}
+
+Vector3f MPU6050_GetAccelerometer()
+{
+	return MPU6050_DevGetAccelerometer(&mpu6050_default);
+}
+
+int16_t MPU6050_GetTemperatureInt()
+{
+	return MPU6050_DevGetTemperatureInt(&mpu6050_default);
+}
+
+Vector3i32 MPU6050_GetGyroscopeInt()
+{
+	return MPU6050_DevGetGyroscopeInt(&mpu6050_default);
+}
+
+Vector3i32 MPU6050_GetAccelerometerInt()
+{
+	return MPU6050_DevGetAccelerometerInt(&mpu6050_default);
+}
+
+void MPU6050_ReadAll(MPU6050_RawSample *sample)
+{
+	MPU6050_DevReadAll(&mpu6050_default, sample);
+}
+
+bool_t MPU6050_StartAcquisition()
+{
+	return MPU6050_DevStartAcquisition(&mpu6050_default);
+}
+
+MPU6050_AcqState MPU6050_GetAcquisitionState()
+{
+	return MPU6050_DevGetAcquisitionState(&mpu6050_default);
+}
+
+bool_t MPU6050_GetAcquisitionResult(MPU6050_RawSample *sample)
+{
+	return MPU6050_DevGetAcquisitionResult(&mpu6050_default, sample);
+}
+
+uint32_t MPU6050_GetAcquisitionTimestamp()
+{
+	return MPU6050_DevGetAcquisitionTimestamp(&mpu6050_default);
+}
+
+void MPU6050_DataReadyEnable(MPU6050_SampleCallback callback)
+{
+	MPU6050_DevDataReadyEnable(&mpu6050_default, callback);
+}
+
+void MPU6050_DataReadyDisable()
+{
+	MPU6050_DevDataReadyDisable(&mpu6050_default);
+}
+
+uint32_t MPU6050_DataReadyGetMissedCount()
+{
+	return MPU6050_DevDataReadyGetMissedCount(&mpu6050_default);
+}
+
+void MPU6050_FifoEnable()
+{
+	MPU6050_DevFifoEnable(&mpu6050_default);
+}
+
+void MPU6050_FifoDisable()
+{
+	MPU6050_DevFifoDisable(&mpu6050_default);
+}
+
+bool_t MPU6050_FifoStartDrain()
+{
+	return MPU6050_DevFifoStartDrain(&mpu6050_default);
+}
+
+MPU6050_AcqState MPU6050_FifoGetState()
+{
+	return MPU6050_DevFifoGetState(&mpu6050_default);
+}
+
+uint16_t MPU6050_FifoGetBatch(MPU6050_RawSample *samples, uint16_t max, bool_t *overflow)
+{
+	return MPU6050_DevFifoGetBatch(&mpu6050_default, samples, max, overflow);
+}
+
+uint16_t MPU6050_FifoRead(MPU6050_RawSample *samples, uint16_t max, bool_t *overflow)
+{
+	return MPU6050_DevFifoRead(&mpu6050_default, samples, max, overflow);
+}
+
+uint32_t MPU6050_FifoGetOverflowCount()
+{
+	return MPU6050_DevFifoGetOverflowCount(&mpu6050_default);
 }
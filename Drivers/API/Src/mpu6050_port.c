@@ -7,54 +7,127 @@
 
 
 #include "mpu6050_port.h"
-#include "API_uart.h"
+#include "API_log.h"
 #include "stdio.h"
 #include "string.h"
 
-static I2C_HandleTypeDef hi2c3;
+// Callback y contexto por línea EXTI (0..15)
+static MPU6050_PortINT_Callback int_callback[16];
+static void *int_context[16];
 
-void MPU6050_PortI2C_Init()
+void MPU6050_PortI2C_Init(I2C_BusId bus)
 {
-
-	hi2c3.Instance = I2C3;
-	hi2c3.Init.ClockSpeed = 100000;
-	hi2c3.Init.DutyCycle = I2C_DUTYCYCLE_2;
-	hi2c3.Init.OwnAddress1 = 0;
-	hi2c3.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
-	hi2c3.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
-	hi2c3.Init.OwnAddress2 = 0;
-	hi2c3.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
-	hi2c3.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
-	if (HAL_I2C_Init(&hi2c3) != HAL_OK)
-	{
-	  Error_Handler();
-	}
-
+	I2C_Bus_Init(bus);
 }
 
 
-void MPU6050_PortI2C_IsReady()
+void MPU6050_PortI2C_IsReady(const MPU6050_PortI2C *i2c)
 {
-	if (HAL_I2C_IsDeviceReady(&hi2c3, ADDRESS_MPU6050 << 1, 1, HAL_MAX_DELAY) != HAL_OK) Error_Handler();
+	if (HAL_I2C_IsDeviceReady(I2C_Bus_GetHandle(i2c->bus), i2c->address << 1, 1, HAL_MAX_DELAY) != HAL_OK) Error_Handler();
 }
 
 
-void MPU6050_PortI2C_WriteRegister(uint8_t reg, uint8_t value, uint8_t MAX_SIZE)
+void MPU6050_PortI2C_WriteRegister(const MPU6050_PortI2C *i2c, uint8_t reg, uint8_t value, uint8_t MAX_SIZE)
 {
-	if(HAL_I2C_Mem_Write(&hi2c3, ADDRESS_MPU6050 << 1 , reg, MAX_SIZE, &value, MAX_SIZE, HAL_MAX_DELAY) != HAL_OK){
-		uartSendString((uint8_t*)"ERROR HANDLER MPU6050 WRITE!\r\n");
+	I2C_Transaction xfer = {
+		.type = I2C_XFER_MEM_WRITE,
+		.dev_addr = i2c->address << 1,
+		.mem_addr = reg,
+		.data = &value,
+		.size = MAX_SIZE,
+	};
+
+	if(I2C_Bus_Transfer(i2c->bus, &xfer) != HAL_OK){
+		LOG("ERROR HANDLER MPU6050 0x%02X WRITE! reg=0x%02X", i2c->address, reg);
 		Error_Handler();
 	}
 }
 
 
-void MPU6050_PortI2C_ReadRegister(uint8_t reg, uint8_t* buffer, uint8_t MAX_SIZE, uint8_t length)
+void MPU6050_PortI2C_ReadRegister(const MPU6050_PortI2C *i2c, uint8_t reg, uint8_t* buffer, uint8_t MAX_SIZE, uint16_t length)
 {
-	if(HAL_I2C_Mem_Read(&hi2c3, ADDRESS_MPU6050 << 1 , reg, MAX_SIZE, buffer, length, HAL_MAX_DELAY) != HAL_OK){
-		uartSendString((uint8_t*)"ERROR HANDLER MPU6050 READ!\r\n");
+	I2C_Transaction xfer = {
+		.type = I2C_XFER_MEM_READ,
+		.dev_addr = i2c->address << 1,
+		.mem_addr = reg,
+		.data = buffer,
+		.size = length,
+	};
+
+	if(I2C_Bus_Transfer(i2c->bus, &xfer) != HAL_OK){
+		LOG("ERROR HANDLER MPU6050 0x%02X READ! reg=0x%02X len=%u", i2c->address, reg, length);
 		Error_Handler();
 	}
 
 }
 
 
+bool_t MPU6050_PortI2C_ReadRegisterAsync(const MPU6050_PortI2C *i2c, uint8_t reg, uint8_t* buffer, uint16_t length, I2C_XferCallback callback, void *context)
+{
+	I2C_Transaction xfer = {
+		.type = I2C_XFER_MEM_READ,
+		.dev_addr = i2c->address << 1,
+		.mem_addr = reg,
+		.data = buffer,
+		.size = length,
+		.callback = callback,
+		.context = context,
+	};
+
+	return I2C_Bus_Submit(i2c->bus, &xfer);
+}
+
+bool_t MPU6050_PortI2C_WriteRegisterAsync(const MPU6050_PortI2C *i2c, uint8_t reg, uint8_t* value, I2C_XferCallback callback, void *context)
+{
+	I2C_Transaction xfer = {
+		.type = I2C_XFER_MEM_WRITE,
+		.dev_addr = i2c->address << 1,
+		.mem_addr = reg,
+		.data = value,
+		.size = 1,
+		.callback = callback,
+		.context = context,
+	};
+
+	return I2C_Bus_Submit(i2c->bus, &xfer);
+}
+
+/*
+ * Configura `line` como EXTI por flanco ascendente y registra `callback(context)` para esa línea.
+ * El reloj del puerto GPIO ya lo habilita MX_GPIO_Init().
+ * Las líneas 5..9 comparten EXTI9_5_IRQn: deshabilitar una no debe apagar el IRQ de las demás,
+ * por eso aquí solo se desconfigura el pin.
+ */
+void MPU6050_PortINT_Init(const MPU6050_PortINT *line, MPU6050_PortINT_Callback callback, void *context)
+{
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+	uint32_t index = POSITION_VAL(line->pin);
+
+	int_context[index] = context;
+	int_callback[index] = callback;
+
+	GPIO_InitStruct.Pin = line->pin;
+	GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING;
+	GPIO_InitStruct.Pull = GPIO_PULLDOWN;
+	HAL_GPIO_Init(line->port, &GPIO_InitStruct);
+
+	__HAL_GPIO_EXTI_CLEAR_IT(line->pin);
+	HAL_NVIC_SetPriority(line->irq, 0, 0);
+	HAL_NVIC_EnableIRQ(line->irq);
+}
+
+void MPU6050_PortINT_Disable(const MPU6050_PortINT *line)
+{
+	uint32_t index = POSITION_VAL(line->pin);
+
+	HAL_GPIO_DeInit(line->port, line->pin);
+	__HAL_GPIO_EXTI_CLEAR_IT(line->pin);
+	int_callback[index] = NULL;
+}
+
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+	uint32_t index = POSITION_VAL(GPIO_Pin);
+
+	if (int_callback[index] != NULL) int_callback[index](int_context[index]);
+}
@@ -0,0 +1,456 @@
+/*
+ * spi_bus.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ */
+
+#include "spi_bus.h"
+
+#define SPI_BUS_CR1_MASK  (SPI_CR1_BR | SPI_CR1_CPOL | SPI_CR1_CPHA)
+
+typedef struct
+{
+    SPI_HandleTypeDef hspi;
+    DMA_HandleTypeDef hdma_rx;
+    DMA_HandleTypeDef hdma_tx;
+    SPI_Transaction   queue[SPI_BUS_QUEUE_LENGTH];
+    volatile uint8_t  head;
+    volatile uint8_t  count;
+    volatile bool_t   active;     // transferencia DMA en curso o bus tomado con SPI_Bus_Acquire
+    uint32_t          cr1;        // BR/CPOL/CPHA cargados actualmente en el periférico
+    bool_t            initialized;
+} SPI_BusState;
+
+typedef struct
+{
+    volatile bool_t            done;
+    volatile HAL_StatusTypeDef status;
+} SPI_BlockingContext;
+
+static SPI_BusState bus;
+
+static void SPI_Bus_DMA_Init(DMA_HandleTypeDef *hdma, DMA_Stream_TypeDef *stream, uint32_t direction, uint32_t priority, IRQn_Type irq);
+static void SPI_Bus_Apply(const SPI_BusDevice *dev);
+static void SPI_Bus_StartNext(void);
+static bool_t SPI_Bus_Advance(void);
+static void SPI_Bus_Complete(SPI_HandleTypeDef *hspi, HAL_StatusTypeDef status);
+static void SPI_Bus_BlockingCallback(HAL_StatusTypeDef status, void *context);
+
+/**
+ * @brief Inicializa SPI2 como maestro full-duplex, sus canales DMA y sus interrupciones.
+ *
+ * Se inicializa una sola vez aunque varios puertos llamen a esta función.
+ *
+ * @details
+ * 1. Configura el periférico en 8 bits, MSB primero y NSS por software, con el prescaler más lento
+ *    (`/256`): ningún dispositivo recibe un reloj fuera de su límite antes de ser seleccionado.
+ * 2. Vincula SPI2_RX a DMA1 Stream3 y SPI2_TX a DMA1 Stream4 (canal 0).
+ * 3. Habilita las interrupciones de ambos streams y de SPI2 (errores del modo DMA).
+ *
+ * @note
+ * - El reloj, CPOL y CPHA de cada transacción los fija el `SPI_BusDevice` destino (ver `SPI_Bus_Apply()`).
+ */
+
+void SPI_Bus_Init(void)
+{
+	if (bus.initialized) return;
+
+	bus.hspi.Instance = SPI_BUS_INSTANCE;
+	bus.hspi.Init.Mode = SPI_MODE_MASTER;
+	bus.hspi.Init.Direction = SPI_DIRECTION_2LINES;
+	bus.hspi.Init.DataSize = SPI_DATASIZE_8BIT;
+	bus.hspi.Init.CLKPolarity = SPI_POLARITY_LOW;
+	bus.hspi.Init.CLKPhase = SPI_PHASE_1EDGE;
+	bus.hspi.Init.NSS = SPI_NSS_SOFT;
+	bus.hspi.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_256;
+	bus.hspi.Init.FirstBit = SPI_FIRSTBIT_MSB;
+	bus.hspi.Init.TIMode = SPI_TIMODE_DISABLE;
+	bus.hspi.Init.CRCCalculation = SPI_CRCCALCULATION_DISABLE;
+	bus.hspi.Init.CRCPolynomial = 10;
+	if (HAL_SPI_Init(&bus.hspi) != HAL_OK)
+	{
+		Error_Handler();
+	}
+	bus.cr1 = READ_BIT(bus.hspi.Instance->CR1, SPI_BUS_CR1_MASK);
+
+	SPI_Bus_DMA_Init(&bus.hdma_rx, DMA1_Stream3, DMA_PERIPH_TO_MEMORY, DMA_PRIORITY_HIGH, DMA1_Stream3_IRQn);
+	__HAL_LINKDMA(&bus.hspi, hdmarx, bus.hdma_rx);
+	SPI_Bus_DMA_Init(&bus.hdma_tx, DMA1_Stream4, DMA_MEMORY_TO_PERIPH, DMA_PRIORITY_MEDIUM, DMA1_Stream4_IRQn);
+	__HAL_LINKDMA(&bus.hspi, hdmatx, bus.hdma_tx);
+
+	HAL_NVIC_SetPriority(SPI2_IRQn, 0, 0);
+	HAL_NVIC_EnableIRQ(SPI2_IRQn);
+
+	bus.head = 0;
+	bus.count = 0;
+	bus.active = false;
+	bus.initialized = true;
+}
+
+static void SPI_Bus_DMA_Init(DMA_HandleTypeDef *hdma, DMA_Stream_TypeDef *stream, uint32_t direction, uint32_t priority, IRQn_Type irq)
+{
+	__HAL_RCC_DMA1_CLK_ENABLE();
+
+	hdma->Instance = stream;
+	hdma->Init.Channel = DMA_CHANNEL_0;
+	hdma->Init.Direction = direction;
+	hdma->Init.PeriphInc = DMA_PINC_DISABLE;
+	hdma->Init.MemInc = DMA_MINC_ENABLE;
+	hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdma->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	hdma->Init.Mode = DMA_NORMAL;
+	hdma->Init.Priority = priority;
+	hdma->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+	if (HAL_DMA_Init(hdma) != HAL_OK)
+	{
+		Error_Handler();
+	}
+
+	HAL_NVIC_SetPriority(irq, 0, 0);
+	HAL_NVIC_EnableIRQ(irq);
+}
+
+/**
+ * @brief Declara un dispositivo del bus: su chip select, su reloj máximo y su modo SPI.
+ *
+ * @param dev          Descriptor a completar; debe seguir siendo válido mientras se use (normalmente `static`).
+ * @param cs_port      Puerto GPIO del chip select.
+ * @param cs_pin       Pin del chip select (`GPIO_PIN_x`).
+ * @param max_clock_hz Frecuencia máxima de SCK según el datasheet del dispositivo.
+ * @param mode         Modo SPI (CPOL/CPHA) del dispositivo.
+ *
+ * @return `true` si existe un prescaler legal; `false` si incluso `PCLK1/256` supera `max_clock_hz`.
+ *
+ * @details
+ * 1. Elige el prescaler más rápido con `PCLK1 / 2^(BR+1) <= max_clock_hz` y lo guarda, junto con
+ *    CPOL/CPHA, como bits de CR1 en `dev->cr1`. El cálculo se hace una sola vez, no por transacción.
+ * 2. Configura el CS como salida en alto (inactivo).
+ *
+ * @note
+ * - Con varios dispositivos en el bus se deben declarar todos antes de la primera transacción,
+ *   para que ningún chip con el CS flotante responda en MISO.
+ * - Debe llamarse después de `SystemClock_Config()`, ya que depende de `HAL_RCC_GetPCLK1Freq()`.
+ *
+ * @example
+ * ```c
+ * static SPI_BusDevice flash;
+ * SPI_Bus_DeviceInit(&flash, GPIOB, GPIO_PIN_12, 50000000, SPI_BUS_MODE_0);   // 21 MHz con PCLK1 = 42 MHz
+ * ```
+ */
+
+bool_t SPI_Bus_DeviceInit(SPI_BusDevice *dev, GPIO_TypeDef *cs_port, uint16_t cs_pin,
+                          uint32_t max_clock_hz, SPI_BusMode mode)
+{
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+	uint32_t pclk = HAL_RCC_GetPCLK1Freq();
+	uint32_t br = 0;
+
+	while (br < 7 && (pclk >> (br + 1)) > max_clock_hz) br++;
+
+	dev->cs_port = cs_port;
+	dev->cs_pin = cs_pin;
+	dev->max_clock_hz = max_clock_hz;
+	dev->mode = mode;
+	dev->cr1 = (br << SPI_CR1_BR_Pos)
+	         | ((mode & 0x2) ? SPI_CR1_CPOL : 0)
+	         | ((mode & 0x1) ? SPI_CR1_CPHA : 0);
+	dev->clock_hz = pclk >> (br + 1);
+
+	HAL_GPIO_WritePin(cs_port, cs_pin, GPIO_PIN_SET);
+	GPIO_InitStruct.Pin = cs_pin;
+	GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+	GPIO_InitStruct.Pull = GPIO_NOPULL;
+	GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+	HAL_GPIO_Init(cs_port, &GPIO_InitStruct);
+
+	return dev->clock_hz <= max_clock_hz;
+}
+
+/**
+ * @brief Devuelve el handle HAL del bus, para transferencias bloqueantes de la HAL.
+ *
+ * @note
+ * - Solo debe usarse entre `SPI_Bus_Acquire()` y `SPI_Bus_Release()`.
+ */
+
+SPI_HandleTypeDef *SPI_Bus_GetHandle(void)
+{
+	return &bus.hspi;
+}
+
+/**
+ * @brief Encola una transacción full-duplex por DMA y retorna sin esperar a que se ejecute.
+ *
+ * La transacción se copia a la cola. Si el bus está libre se lanza inmediatamente; si no, se lanzará
+ * desde la interrupción de fin de la transacción anterior o desde `SPI_Bus_Release()`.
+ *
+ * @param xfer Descripción de la transacción. El descriptor y los buffers deben seguir siendo válidos
+ *             hasta que se invoque `xfer->callback`.
+ *
+ * @return `true` si la transacción fue encolada, `false` si la cola está llena.
+ *
+ * @details
+ * - Antes de seleccionar el CS se carga la configuración del dispositivo, solo si difiere de la actual.
+ * - El CS se libera antes de invocar el callback, en contexto de interrupción, con `HAL_OK` o `HAL_ERROR`.
+ * - Puede llamarse desde el lazo principal, desde otra interrupción o desde el callback de otra
+ *   transacción del bus (la nueva se lanza al volver el callback).
+ */
+
+bool_t SPI_Bus_Submit(const SPI_Transaction *xfer)
+{
+	bool_t start = false;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	if (bus.count >= SPI_BUS_QUEUE_LENGTH)
+	{
+		__set_PRIMASK(primask);
+		return false;
+	}
+
+	uint8_t slot = (bus.head + bus.count) % SPI_BUS_QUEUE_LENGTH;
+	bus.queue[slot] = *xfer;
+	bus.count++;
+
+	if (!bus.active)
+	{
+		bus.active = true;
+		start = true;
+	}
+
+	__set_PRIMASK(primask);
+
+	if (start) SPI_Bus_StartNext();
+	return true;
+}
+
+/**
+ * @brief Ejecuta una transacción de forma bloqueante a través de la cola del bus.
+ *
+ * @param xfer Transacción. Los campos `callback` y `context` se ignoran.
+ *
+ * @return Estado final de la transacción.
+ *
+ * @note
+ * - No debe llamarse desde una interrupción ni con el bus tomado por `SPI_Bus_Acquire()`.
+ */
+
+HAL_StatusTypeDef SPI_Bus_Transfer(const SPI_Transaction *xfer)
+{
+	SPI_BlockingContext blocking = { .done = false, .status = HAL_ERROR };
+	SPI_Transaction request = *xfer;
+
+	request.callback = SPI_Bus_BlockingCallback;
+	request.context = &blocking;
+
+	while (!SPI_Bus_Submit(&request)) {
+	}
+	while (!blocking.done) {
+	}
+	return blocking.status;
+}
+
+/**
+ * @brief Indica si el bus no tiene transacciones activas ni pendientes y no está tomado.
+ */
+
+bool_t SPI_Bus_IsIdle(void)
+{
+	return !bus.active;
+}
+
+/**
+ * @brief Toma el bus para transferencias por consulta (HAL bloqueante o registros LL).
+ *
+ * @param dev Dispositivo con el que se va a operar; su reloj y modo quedan cargados en SPI2.
+ *
+ * @details
+ * 1. Espera a que termine la cola DMA en curso y marca el bus como ocupado.
+ * 2. Aplica la configuración de `dev` si difiere de la actual.
+ *
+ * Las transacciones que se encolen mientras el bus está tomado esperan a `SPI_Bus_Release()`.
+ * El CS lo maneja el llamador (`SPI_Bus_Select()` o directamente por BSRR).
+ *
+ * @note
+ * - Solo desde el lazo principal: la espera depende de las interrupciones del bus.
+ */
+
+void SPI_Bus_Acquire(const SPI_BusDevice *dev)
+{
+	while (1)
+	{
+		uint32_t primask = __get_PRIMASK();
+		__disable_irq();
+		if (!bus.active)
+		{
+			bus.active = true;
+			__set_PRIMASK(primask);
+			break;
+		}
+		__set_PRIMASK(primask);
+	}
+	SPI_Bus_Apply(dev);
+}
+
+/**
+ * @brief Libera el bus tomado con `SPI_Bus_Acquire()` y lanza las transacciones encoladas mientras tanto.
+ */
+
+void SPI_Bus_Release(void)
+{
+	bool_t more;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	more = (bus.count > 0);
+	bus.active = more;
+	__set_PRIMASK(primask);
+
+	if (more) SPI_Bus_StartNext();
+}
+
+void SPI_Bus_Select(const SPI_BusDevice *dev)
+{
+	HAL_GPIO_WritePin(dev->cs_port, dev->cs_pin, GPIO_PIN_RESET);
+}
+
+void SPI_Bus_Deselect(const SPI_BusDevice *dev)
+{
+	HAL_GPIO_WritePin(dev->cs_port, dev->cs_pin, GPIO_PIN_SET);
+}
+
+static void SPI_Bus_BlockingCallback(HAL_StatusTypeDef status, void *context)
+{
+	SPI_BlockingContext *blocking = (SPI_BlockingContext *)context;
+	blocking->status = status;
+	blocking->done = true;
+}
+
+/*
+ * Carga BR/CPOL/CPHA del dispositivo solo si cambian respecto de la transacción anterior
+ * (dispositivos iguales o el mismo chip no pagan la reconfiguración). CPOL/CPHA solo pueden
+ * cambiarse con SPE en 0, así que se espera a que SPI2 termine y se deshabilita; luego se vuelve
+ * a habilitar para que SCK tome el nuevo nivel de reposo antes de bajar el CS.
+ */
+static void SPI_Bus_Apply(const SPI_BusDevice *dev)
+{
+	if (dev->cr1 == bus.cr1) return;
+
+	while (__HAL_SPI_GET_FLAG(&bus.hspi, SPI_FLAG_BSY)) {
+	}
+	__HAL_SPI_DISABLE(&bus.hspi);
+	MODIFY_REG(bus.hspi.Instance->CR1, SPI_BUS_CR1_MASK, dev->cr1);
+	__HAL_SPI_ENABLE(&bus.hspi);
+	bus.cr1 = dev->cr1;
+}
+
+/*
+ * Lanza la transacción en la cabeza de la cola. Si la HAL la rechaza se completa con error
+ * y se pasa a la siguiente, de modo que un fallo nunca bloquea la cola.
+ */
+static void SPI_Bus_StartNext(void)
+{
+	while (1)
+	{
+		SPI_Transaction *xfer = &bus.queue[bus.head];
+		HAL_StatusTypeDef status;
+
+		SPI_Bus_Apply(xfer->device);
+		SPI_Bus_Select(xfer->device);
+
+		if (xfer->rx == NULL)
+			status = HAL_SPI_Transmit_DMA(&bus.hspi, (uint8_t *)xfer->tx, xfer->size);
+		else if (xfer->tx == NULL)
+			status = HAL_SPI_Receive_DMA(&bus.hspi, xfer->rx, xfer->size);
+		else
+			status = HAL_SPI_TransmitReceive_DMA(&bus.hspi, (uint8_t *)xfer->tx, xfer->rx, xfer->size);
+
+		if (status == HAL_OK) return;
+
+		SPI_Bus_Deselect(xfer->device);
+
+		SPI_XferCallback callback = xfer->callback;
+		void *context = xfer->context;
+
+		uint32_t primask = __get_PRIMASK();
+		__disable_irq();
+		bus.head = (bus.head + 1) % SPI_BUS_QUEUE_LENGTH;
+		bus.count--;
+		__set_PRIMASK(primask);
+
+		if (callback != NULL) callback(HAL_ERROR, context);
+		if (!SPI_Bus_Advance()) return;
+	}
+}
+
+/*
+ * Decide, ya invocado el callback de la transacción saliente, si el bus sigue activo.
+ * Mientras corre el callback `active` permanece en true, así un SPI_Bus_Submit() desde el
+ * callback solo encola y la transacción se lanza una única vez, desde quien llamó al callback.
+ */
+static bool_t SPI_Bus_Advance(void)
+{
+	bool_t more;
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	more = (bus.count > 0);
+	if (!more) bus.active = false;
+	__set_PRIMASK(primask);
+
+	return more;
+}
+
+static void SPI_Bus_Complete(SPI_HandleTypeDef *hspi, HAL_StatusTypeDef status)
+{
+	if (hspi != &bus.hspi) return;
+
+	SPI_Transaction *xfer = &bus.queue[bus.head];
+	SPI_XferCallback callback = xfer->callback;
+	void *context = xfer->context;
+
+	SPI_Bus_Deselect(xfer->device);
+
+	bus.head = (bus.head + 1) % SPI_BUS_QUEUE_LENGTH;
+	bus.count--;
+
+	if (callback != NULL) callback(status, context);
+	if (SPI_Bus_Advance()) SPI_Bus_StartNext();
+}
+
+void SPI_Bus_IRQHandler(void)
+{
+	HAL_SPI_IRQHandler(&bus.hspi);
+}
+
+void SPI_Bus_DMA_RxIRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&bus.hdma_rx);
+}
+
+void SPI_Bus_DMA_TxIRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&bus.hdma_tx);
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+	SPI_Bus_Complete(hspi, HAL_OK);
+}
+
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+	SPI_Bus_Complete(hspi, HAL_OK);
+}
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+	SPI_Bus_Complete(hspi, HAL_OK);
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+	SPI_Bus_Complete(hspi, HAL_ERROR);
+}
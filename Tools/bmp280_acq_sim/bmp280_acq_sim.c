@@ -0,0 +1,477 @@
+/*
+ * bmp280_acq_sim.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ *
+ * Verificación en el host del motor de adquisición asíncrona del BMP280 (Drivers/API/Src/bmp280_driver.c).
+ * El driver solo depende de bmp280_port, así que se enlaza contra un puerto SPI simulado con el mapa
+ * de registros de dos sensores (ID, calibración en 0x88, ráfaga en 0xF7..0xFC) en lugar de
+ * bmp280_port.c y spi_bus.c.
+ *
+ * BMP280_PortSPI_TransferDMA() simulada completa cada ráfaga de dos formas:
+ * - asíncrona: queda en una cola, como en spi_bus, hasta que el banco "atiende la interrupción" con pump();
+ * - síncrona: el callback de fin se invoca antes de retornar.
+ * También puede rechazar el lanzamiento (cola del bus llena) o terminar la ráfaga con error.
+ * En modo forzado el sensor simulado solo convierte al escribirse CTRL_MEAS con mode = 01.
+ *
+ * Compilar: gcc -O2 -Wall -I../hal_stub -I../../Drivers/API/Inc -o bmp280_acq_sim bmp280_acq_sim.c \
+ *               ../hal_stub/hal_stub.c ../../Drivers/API/Src/bmp280_driver.c \
+ *               ../../Drivers/API/Src/bmp280_comp.c ../../Drivers/API/Src/API_altitude.c -lm
+ *           (agregar -DBMP280_COMP_BACKEND=BMP280_COMP_INT32 o BMP280_COMP_INT64 para otro back-end)
+ * Uso:      ./bmp280_acq_sim     (código de salida 0 si todas las pruebas pasan)
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "bmp280_driver.h"
+#include "API_delay.h"
+
+#define QUEUE_LENGTH  4
+
+/* En SPI se transmiten 7 bits de dirección; el bit 7 del registro se da por implícito */
+#define SPI_REG(addr)  (((addr) & 0x7F) | 0x80)
+
+/* Ejemplo del datasheet BMP280, sección 8.2: 25.08 °C y 100653.27 Pa (100656 Pa con la fórmula de 32 bits) */
+#define EXAMPLE_ADC_T  519888
+#define EXAMPLE_ADC_P  415148
+#if BMP280_COMP_BACKEND == BMP280_COMP_INT32
+#define EXAMPLE_HPA    1006.56
+#else
+#define EXAMPLE_HPA    1006.53
+#endif
+
+typedef struct
+{
+	uint16_t cs_pin;
+	uint8_t  regs[256];
+	int32_t  forced_adc_P;   // muestra que produce el próximo disparo forzado
+	int32_t  forced_adc_T;
+	unsigned conversions;
+} FakeSensor;
+
+typedef struct
+{
+	const SPI_BusDevice     *spi;
+	const uint8_t           *tx;
+	uint8_t                 *rx;
+	uint16_t                size;
+	BMP280_PortSPI_Callback callback;
+	void                    *context;
+} FakeXfer;
+
+/* Datasheet BMP280, sección 8.2: dig_T1..dig_P9 en el orden de 0x88..0x9F */
+static const int32_t datasheet_trim[12] = {
+	27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000
+};
+
+static FakeSensor sensors[2] = { { GPIO_PIN_4 }, { GPIO_PIN_12 } };
+
+static int sync_mode;
+static FakeXfer queue[QUEUE_LENGTH];
+static unsigned queue_len;
+static unsigned started;
+static HAL_StatusTypeDef start_status = HAL_OK;   // resultado del lanzamiento
+static uint16_t fail_start_pin;                    // 0: ninguno
+static HAL_StatusTypeDef done_status = HAL_OK;     // resultado de la ráfaga
+static int blocking_while_queued;
+static uint32_t now_us;
+static int failures;
+
+static bmp280_dev_t baro_a, baro_b;
+
+#define CHECK(cond)                                                              \
+	do {                                                                         \
+		if (!(cond)) { printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } \
+	} while (0)
+
+#define CHECK_NEAR(value, expected, tol)  CHECK(fabs((double)(value) - (expected)) <= (tol))
+
+static FakeSensor *SensorFor(const SPI_BusDevice *spi)
+{
+	for (unsigned i = 0; i < 2; i++)
+	{
+		if (sensors[i].cs_pin == spi->cs_pin) return &sensors[i];
+	}
+	printf("  unknown CS 0x%04X\n", spi->cs_pin);
+	failures++;
+	return &sensors[0];
+}
+
+static void SensorSetSample(FakeSensor *s, int32_t adc_P, int32_t adc_T)
+{
+	s->regs[BMP280_REG_PRESS_MSB]     = (uint8_t)(adc_P >> 12);
+	s->regs[BMP280_REG_PRESS_MSB + 1] = (uint8_t)(adc_P >> 4);
+	s->regs[BMP280_REG_PRESS_MSB + 2] = (uint8_t)((adc_P & 0xF) << 4);
+	s->regs[BMP280_REG_TEMP_MSB]      = (uint8_t)(adc_T >> 12);
+	s->regs[BMP280_REG_TEMP_MSB + 1]  = (uint8_t)(adc_T >> 4);
+	s->regs[BMP280_REG_TEMP_MSB + 2]  = (uint8_t)((adc_T & 0xF) << 4);
+}
+
+static void SensorInit(FakeSensor *s)
+{
+	memset(s->regs, 0, sizeof(s->regs));
+	s->regs[BMP280_REG_ID] = BMP280_CHIP_ID;
+	for (unsigned i = 0; i < 12; i++)
+	{
+		s->regs[BMP280_REG_CALIB_START + 2 * i]     = (uint8_t)(datasheet_trim[i] & 0xFF);
+		s->regs[BMP280_REG_CALIB_START + 2 * i + 1] = (uint8_t)((datasheet_trim[i] >> 8) & 0xFF);
+	}
+}
+
+/* Full-duplex como el sensor: el primer byte es la dirección y el resto sale del mapa de registros */
+static void Finish(const FakeXfer *xfer)
+{
+	FakeSensor *s = SensorFor(xfer->spi);
+	uint8_t reg = SPI_REG(xfer->tx[0]);
+
+	CHECK(xfer->tx[0] & 0x80);
+	xfer->rx[0] = 0xFF;
+	for (uint16_t i = 1; i < xfer->size; i++) xfer->rx[i] = s->regs[(reg + i - 1) & 0xFF];
+	if (xfer->callback != NULL) xfer->callback(done_status, xfer->context);
+}
+
+static int pump(void)
+{
+	if (queue_len == 0) return 0;
+
+	FakeXfer done = queue[0];
+	memmove(&queue[0], &queue[1], --queue_len * sizeof(queue[0]));
+	Finish(&done);
+	return 1;
+}
+
+static void PumpAll(void)
+{
+	while (pump()) {
+	}
+}
+
+/* Puerto SPI simulado */
+
+void BMP280_PortSPI_DeviceInit(SPI_BusDevice *spi, GPIO_TypeDef *cs_port, uint16_t cs_pin)
+{
+	memset(spi, 0, sizeof(*spi));
+	spi->cs_port = cs_port;
+	spi->cs_pin = cs_pin;
+	spi->max_clock_hz = BMP280_SPI_MAX_CLOCK;
+	spi->mode = BMP280_SPI_MODE;
+}
+
+void BMP280_PortSPI_Read(const SPI_BusDevice *spi, uint8_t reg, uint8_t *data, uint16_t size)
+{
+	FakeSensor *s = SensorFor(spi);
+
+	if (queue_len != 0) blocking_while_queued++;
+	reg = SPI_REG(reg);
+	for (uint16_t i = 0; i < size; i++) data[i] = s->regs[(reg + i) & 0xFF];
+}
+
+void BMP280_PortSPI_Write(const SPI_BusDevice *spi, uint8_t reg, uint8_t value)
+{
+	FakeSensor *s = SensorFor(spi);
+
+	if (queue_len != 0) blocking_while_queued++;
+	if (SPI_REG(reg) == BMP280_REG_RESET) return;
+	s->regs[SPI_REG(reg)] = value;
+	if (SPI_REG(reg) == BMP280_REG_CTRL_MEAS && (value & 0x03) == BMP280_MODE_FORCED)
+	{
+		// Conversión única: deja la muestra en 0xF7..0xFC y vuelve a sleep
+		SensorSetSample(s, s->forced_adc_P, s->forced_adc_T);
+		s->regs[BMP280_REG_CTRL_MEAS] = value & ~0x03;
+		s->conversions++;
+	}
+}
+
+HAL_StatusTypeDef BMP280_PortSPI_TransferDMA(const SPI_BusDevice *spi, const uint8_t *tx, uint8_t *rx, uint16_t size,
+                                             BMP280_PortSPI_Callback callback, void *context)
+{
+	if (start_status != HAL_OK) return start_status;
+	if (fail_start_pin != 0 && spi->cs_pin == fail_start_pin) return HAL_ERROR;
+	if (queue_len == QUEUE_LENGTH) return HAL_BUSY;
+
+	FakeXfer xfer = { spi, tx, rx, size, callback, context };
+	started++;
+	if (sync_mode) Finish(&xfer);
+	else queue[queue_len++] = xfer;
+	return HAL_OK;
+}
+
+bool_t delayUsInit(void)
+{
+	return true;
+}
+
+void delayUs(uint32_t us)
+{
+}
+
+uint32_t delayGetCycles(void)
+{
+	return 0;
+}
+
+uint32_t delayGetMicros(void)
+{
+	return now_us;
+}
+
+/* Resultado esperado de una muestra, calculado directamente con bmp280_comp */
+static void Expected(const bmp280_dev_t *dev, int32_t adc_P, int32_t adc_T, BMP280_Measurement *m)
+{
+	BMP280_CompCoeffs c = dev->comp;
+	BMP280_TFine t_fine;
+
+#if BMP280_COMP_BACKEND == BMP280_COMP_FLOAT
+	m->temperature = BMP280_CompTemperatureFloat(&c, adc_T, &t_fine);
+	m->pressure = BMP280_CompPressureFloat(&c, adc_P, t_fine) * 0.01f;
+#elif BMP280_COMP_BACKEND == BMP280_COMP_INT32
+	m->temperature = BMP280_CompTemperatureInt32(&c, adc_T, &t_fine) * 0.01f;
+	m->pressure = BMP280_CompPressureInt32(&c, adc_P, t_fine) * 0.01f;
+#else
+	m->temperature = BMP280_CompTemperatureInt32(&c, adc_T, &t_fine) * 0.01f;
+	m->pressure = BMP280_CompPressureInt64(&c, adc_P, t_fine) * (1.0f / 25600.0f);
+#endif
+}
+
+static void Reset(int sync)
+{
+	PumpAll();
+	sync_mode = sync;
+	started = 0;
+	start_status = HAL_OK;
+	fail_start_pin = 0;
+	done_status = HAL_OK;
+	blocking_while_queued = 0;
+	SensorSetSample(&sensors[0], EXAMPLE_ADC_P, EXAMPLE_ADC_T);
+}
+
+static void TestInit(void)
+{
+	printf("init: chip id, calibration and standard profile\n");
+	CHECK(sensors[0].regs[BMP280_REG_CTRL_MEAS] ==
+	      ((BMP280_OSRS_X1 << BMP280_OSRS_T_POS) | (BMP280_OSRS_X4 << BMP280_OSRS_P_POS) | BMP280_MODE_NORMAL));
+	CHECK(sensors[0].regs[BMP280_REG_CONFIG] ==
+	      ((BMP280_STANDBY_125MS << BMP280_T_SB_POS) | (BMP280_FILTER_4 << BMP280_FILTER_POS)));
+	CHECK(baro_a.acq_tx[0] == (BMP280_REG_PRESS_MSB | 0x80));
+	CHECK(BMP280_DevGetAcquisitionState(&baro_a) == BMP280_ACQ_IDLE);
+	CHECK(BMP280_DevGetAcquisitionState(&baro_b) == BMP280_ACQ_IDLE);
+}
+
+static void TestAsync(void)
+{
+	BMP280_Measurement m = { 0 };
+
+	printf("acquisition, asynchronous completion\n");
+	Reset(0);
+	CHECK(BMP280_DevStartAcquisition(&baro_a));
+	CHECK(BMP280_DevGetAcquisitionState(&baro_a) == BMP280_ACQ_BUSY);
+	CHECK(!BMP280_DevStartAcquisition(&baro_a));
+	CHECK(!BMP280_DevGetAcquisitionResult(&baro_a, &m));
+	CHECK(BMP280_DevGetAcquisitionState(&baro_a) == BMP280_ACQ_BUSY);
+	CHECK(started == 1);
+
+	CHECK(pump());
+	CHECK(BMP280_DevGetAcquisitionState(&baro_a) == BMP280_ACQ_READY);
+	CHECK(BMP280_DevGetAcquisitionResult(&baro_a, &m));
+	CHECK_NEAR(m.temperature, 25.08, 0.01);
+	CHECK_NEAR(m.pressure, EXAMPLE_HPA, 0.01);
+	CHECK(BMP280_DevGetAcquisitionState(&baro_a) == BMP280_ACQ_IDLE);
+	CHECK(!BMP280_DevGetAcquisitionResult(&baro_a, &m));
+}
+
+static void TestSync(void)
+{
+	BMP280_Measurement m = { 0 };
+
+	printf("acquisition, completion inside the start call\n");
+	Reset(1);
+	CHECK(BMP280_DevStartAcquisition(&baro_a));
+	CHECK(BMP280_DevGetAcquisitionState(&baro_a) == BMP280_ACQ_READY);
+	CHECK(BMP280_DevGetAcquisitionResult(&baro_a, &m));
+	CHECK_NEAR(m.temperature, 25.08, 0.01);
+	CHECK_NEAR(m.pressure, EXAMPLE_HPA, 0.01);
+
+	memset(&m, 0, sizeof(m));
+	BMP280_DevReadAll(&baro_a, &m);
+	CHECK_NEAR(m.pressure, EXAMPLE_HPA, 0.01);
+	CHECK(BMP280_DevGetAcquisitionState(&baro_a) == BMP280_ACQ_IDLE);
+	CHECK(started == 2);
+}
+
+static void TestBurstDecode(void)
+{
+	static const int32_t samples[][2] = {
+		{ 0x00000, 0x80000 }, { 0xFFFFF, 0x7FFF0 }, { 0x5A5A5, 0x76543 }, { 300001, 540007 },
+	};
+	BMP280_Measurement m, expected;
+
+	printf("burst decode (20-bit adc_P and adc_T from 0xF7..0xFC)\n");
+	Reset(1);
+	for (unsigned i = 0; i < sizeof(samples) / sizeof(samples[0]); i++)
+	{
+		SensorSetSample(&sensors[0], samples[i][0], samples[i][1]);
+		CHECK(BMP280_DevStartAcquisition(&baro_a));
+		CHECK(BMP280_DevGetAcquisitionResult(&baro_a, &m));
+		Expected(&baro_a, samples[i][0], samples[i][1], &expected);
+		CHECK(m.temperature == expected.temperature);
+		CHECK(m.pressure == expected.pressure);
+	}
+}
+
+static void TestErrors(void)
+{
+	BMP280_Measurement m;
+
+	printf("failed burst and rejected start\n");
+	Reset(0);
+	done_status = HAL_ERROR;
+	CHECK(BMP280_DevStartAcquisition(&baro_a));
+	pump();
+	CHECK(BMP280_DevGetAcquisitionState(&baro_a) == BMP280_ACQ_ERROR);
+	CHECK(!BMP280_DevGetAcquisitionResult(&baro_a, &m));
+	CHECK(BMP280_DevGetAcquisitionState(&baro_a) == BMP280_ACQ_IDLE);
+
+	done_status = HAL_OK;
+	start_status = HAL_BUSY;
+	CHECK(!BMP280_DevStartAcquisition(&baro_a));
+	CHECK(BMP280_DevGetAcquisitionState(&baro_a) == BMP280_ACQ_IDLE);
+	start_status = HAL_OK;
+	CHECK(BMP280_DevStartAcquisition(&baro_a));
+	pump();
+	CHECK(BMP280_DevGetAcquisitionResult(&baro_a, &m));
+}
+
+static void TestSequencer(int sync)
+{
+	static bmp280_dev_t *const baros[] = { &baro_a, &baro_b };
+	BMP280_Measurement a, b, expected_b;
+
+	printf("sequencer, two sensors (%s)\n", sync ? "sync" : "async");
+	Reset(sync);
+	SensorSetSample(&sensors[1], 416000, 530000);
+	Expected(&baro_b, 416000, 530000, &expected_b);
+
+	CHECK(BMP280_SeqStart(baros, 2));
+	if (!sync)
+	{
+		CHECK(BMP280_SeqGetState() == BMP280_ACQ_BUSY);
+		CHECK(!BMP280_SeqStart(baros, 2));
+		CHECK(!BMP280_DevStartAcquisition(&baro_b));
+		CHECK(BMP280_DevGetAcquisitionState(&baro_b) == BMP280_ACQ_BUSY);
+		CHECK(pump());
+		CHECK(BMP280_DevGetAcquisitionState(&baro_a) == BMP280_ACQ_READY);
+		CHECK(BMP280_SeqGetState() == BMP280_ACQ_BUSY);
+		CHECK(pump());
+		CHECK(!pump());
+	}
+	CHECK(started == 2);
+	CHECK(BMP280_SeqGetState() == BMP280_ACQ_READY);
+	CHECK(BMP280_DevGetAcquisitionResult(&baro_a, &a));
+	CHECK(BMP280_DevGetAcquisitionResult(&baro_b, &b));
+	CHECK_NEAR(a.pressure, EXAMPLE_HPA, 0.01);
+	CHECK(b.pressure == expected_b.pressure && b.temperature == expected_b.temperature);
+	CHECK(blocking_while_queued == 0);
+}
+
+static void TestSequencerFailedStart(void)
+{
+	static bmp280_dev_t *const baros[] = { &baro_a, &baro_b };
+	BMP280_Measurement a, b;
+
+	printf("sequencer, second start rejected\n");
+	Reset(0);
+	fail_start_pin = baro_b.spi.cs_pin;
+	CHECK(BMP280_SeqStart(baros, 2));
+	PumpAll();
+	CHECK(BMP280_SeqGetState() == BMP280_ACQ_READY);
+	CHECK(BMP280_DevGetAcquisitionResult(&baro_a, &a));
+	CHECK(BMP280_DevGetAcquisitionState(&baro_b) == BMP280_ACQ_ERROR);
+	CHECK(!BMP280_DevGetAcquisitionResult(&baro_b, &b));
+	CHECK(BMP280_DevGetAcquisitionState(&baro_b) == BMP280_ACQ_IDLE);
+
+	fail_start_pin = baro_a.spi.cs_pin;
+	CHECK(!BMP280_SeqStart(baros, 2));
+	CHECK(BMP280_SeqGetState() == BMP280_ACQ_IDLE);
+	CHECK(BMP280_DevGetAcquisitionState(&baro_a) == BMP280_ACQ_IDLE);
+	CHECK(BMP280_DevGetAcquisitionState(&baro_b) == BMP280_ACQ_IDLE);
+}
+
+/* Un paso de TaskBaro (Core/Src/main.c) en modo forzado; retorna true si publicó una muestra */
+static bool_t BaroForcedStep(bmp280_dev_t *dev, BMP280_Measurement *m)
+{
+	bool_t published;
+
+	if (BMP280_DevGetAcquisitionState(dev) == BMP280_ACQ_BUSY) return false;
+	published = BMP280_DevGetAcquisitionResult(dev, m);
+	if (BMP280_DevIsConversionDone(dev)) BMP280_DevStartAcquisition(dev);
+	else BMP280_DevTriggerConversion(dev);
+	return published;
+}
+
+static void TestForcedMode(void)
+{
+	BMP280_Measurement m, expected;
+	unsigned samples = 0;
+
+	printf("forced mode: trigger, wait t_meas, burst read\n");
+	Reset(1);
+	now_us = 0;
+	CHECK(BMP280_DevSetProfile(&baro_a, BMP280_PROFILE_WEATHER_MONITORING));
+	CHECK((sensors[0].regs[BMP280_REG_CTRL_MEAS] & 0x03) == BMP280_MODE_SLEEP);
+	CHECK(BMP280_DevGetSamplePeriodUs(&baro_a) == BMP280_DevGetMeasurementTimeUs(&baro_a));
+
+	// Sin disparo no hay muestra nueva: la ráfaga devolvería la última conversión
+	CHECK(!BMP280_DevIsConversionDone(&baro_a));
+
+	for (unsigned run = 0; run < 8; run++)
+	{
+		sensors[0].forced_adc_P = EXAMPLE_ADC_P + 1000 * (int32_t)run;
+		sensors[0].forced_adc_T = EXAMPLE_ADC_T;
+		if (BaroForcedStep(&baro_a, &m))
+		{
+			// Publicada en la ejecución `run`: disparada dos ejecuciones antes
+			Expected(&baro_a, EXAMPLE_ADC_P + 1000 * (int32_t)(run - 2), EXAMPLE_ADC_T, &expected);
+			CHECK(m.pressure == expected.pressure);
+			samples++;
+		}
+		now_us += 500000;
+	}
+	CHECK(samples == 3);
+	CHECK(sensors[0].conversions == 4);
+
+	// El disparo se rechaza mientras la conversión está pendiente, y no se lee antes de t_meas
+	Reset(1);
+	CHECK(BMP280_DevTriggerConversion(&baro_a));
+	CHECK(!BMP280_DevTriggerConversion(&baro_a));
+	now_us += BMP280_DevGetMeasurementTimeUs(&baro_a) - 1;
+	CHECK(!BMP280_DevIsConversionDone(&baro_a));
+	now_us += 1;
+	CHECK(BMP280_DevIsConversionDone(&baro_a));
+
+	CHECK(BMP280_DevSetProfile(&baro_a, BMP280_PROFILE_STANDARD));
+	CHECK(!BMP280_DevTriggerConversion(&baro_a));
+}
+
+int main(void)
+{
+	SensorInit(&sensors[0]);
+	SensorInit(&sensors[1]);
+	sync_mode = 1;
+	BMP280_DevInit(&baro_a, GPIOA, sensors[0].cs_pin);
+	BMP280_DevInit(&baro_b, GPIOB, sensors[1].cs_pin);
+
+	TestInit();
+	TestAsync();
+	TestSync();
+	TestBurstDecode();
+	TestErrors();
+	TestSequencer(0);
+	TestSequencer(1);
+	TestSequencerFailedStart();
+	TestForcedMode();
+
+	printf("%s (%d failures)\n", failures ? "FAILED" : "OK", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,173 @@
+/*
+ * bmp280_comp_check.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ *
+ * Banco de exactitud en el host de los back-ends de compensación del BMP280 (Drivers/API/Src/bmp280_comp.c).
+ * Recorre todo el rango de 20 bits de adc_T y adc_P y compara, en los puntos cuyo resultado de
+ * referencia cae dentro del rango de operación del sensor (-40..85 °C, 300..1100 hPa):
+ * - presión `float` e `int32` contra la referencia de 64 bits de Bosch (Q24.8);
+ * - temperatura `float` contra la entera de Bosch (0.01 °C).
+ * También informa el tiempo medio por llamada en el host, solo como referencia relativa; los ciclos
+ * en el Cortex-M4 se miden con BMP280_COMP_BENCHMARK=1 (BMP280_CompMeasureCycles(), ver main.c).
+ *
+ * Compilar: gcc -O2 -Wall -I../../Drivers/API/Inc -o bmp280_comp_check bmp280_comp_check.c \
+ *               ../../Drivers/API/Src/bmp280_comp.c -lm
+ * Uso:      ./bmp280_comp_check [paso] [calib]
+ *           paso:  separación entre códigos ADC recorridos (por defecto 64)
+ *           calib: los 24 bytes leídos desde 0x88 en hexadecimal (por defecto, el ejemplo del datasheet)
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bmp280_comp.h"
+
+#define ADC_MAX      0xFFFFF
+#define T_MIN_X100   (-4000)
+#define T_MAX_X100   8500
+#define P_MIN_PA     30000.0
+#define P_MAX_PA     110000.0
+
+/* Datasheet BMP280, sección 8.2: dig_T1..dig_P9 */
+static const int32_t datasheet_trim[12] = {
+	27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000
+};
+
+typedef struct
+{
+	double   max_err;
+	double   sum_err;
+	int32_t  worst_t, worst_p;
+	uint64_t count;
+} ErrorStats;
+
+static void Track(ErrorStats *s, double err, int32_t adc_T, int32_t adc_P)
+{
+	err = fabs(err);
+	s->sum_err += err;
+	s->count++;
+	if (err > s->max_err)
+	{
+		s->max_err = err;
+		s->worst_t = adc_T;
+		s->worst_p = adc_P;
+	}
+}
+
+static void Report(const char *name, const char *unit, const ErrorStats *s)
+{
+	printf("  %-18s max %8.3f %s  mean %7.4f %s  (adc_T=%d adc_P=%d)\n", name, s->max_err, unit,
+	       s->count ? s->sum_err / s->count : 0.0, unit, s->worst_t, s->worst_p);
+}
+
+static int ParseCalib(const char *hex, uint8_t *calib)
+{
+	if (strlen(hex) != 2 * BMP280_CALIB_LENGTH) return 0;
+	for (int i = 0; i < BMP280_CALIB_LENGTH; i++)
+	{
+		unsigned byte;
+		if (sscanf(&hex[2 * i], "%2x", &byte) != 1) return 0;
+		calib[i] = (uint8_t)byte;
+	}
+	return 1;
+}
+
+static double Seconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* Tiempo medio por llamada en el host (ns), sobre una rejilla de códigos válidos */
+static void HostTiming(const BMP280_CompCoeffs *c)
+{
+	enum { N = 2000000 };
+	volatile float sink_f = 0;
+	volatile uint32_t sink_u = 0;
+	int32_t t_fine;
+	float t_fine_f;
+	double t0;
+
+	BMP280_CompTemperatureInt32(c, 519888, &t_fine);
+	BMP280_CompTemperatureFloat(c, 519888, &t_fine_f);
+
+	printf("host time per call (relative only):\n");
+	t0 = Seconds();
+	for (int i = 0; i < N; i++) sink_u += BMP280_CompPressureInt64(c, 300000 + (i & 0x3FFFF), t_fine);
+	printf("  pressure int64     %6.1f ns\n", (Seconds() - t0) * 1e9 / N);
+	t0 = Seconds();
+	for (int i = 0; i < N; i++) sink_u += BMP280_CompPressureInt32(c, 300000 + (i & 0x3FFFF), t_fine);
+	printf("  pressure int32     %6.1f ns\n", (Seconds() - t0) * 1e9 / N);
+	t0 = Seconds();
+	for (int i = 0; i < N; i++) sink_f += BMP280_CompPressureFloat(c, 300000 + (i & 0x3FFFF), t_fine_f);
+	printf("  pressure float     %6.1f ns\n", (Seconds() - t0) * 1e9 / N);
+	(void)sink_f;
+	(void)sink_u;
+}
+
+int main(int argc, char **argv)
+{
+	int32_t step = (argc > 1) ? atoi(argv[1]) : 64;
+	uint8_t calib[BMP280_CALIB_LENGTH];
+	BMP280_CompCoeffs c;
+	ErrorStats temp_float = {0}, press_float = {0}, press_int32 = {0};
+	uint64_t skipped = 0;
+
+	if (step <= 0) step = 64;
+	if (argc > 2)
+	{
+		if (!ParseCalib(argv[2], calib))
+		{
+			fprintf(stderr, "calib: se esperan %d bytes en hexadecimal\n", BMP280_CALIB_LENGTH);
+			return 2;
+		}
+	}
+	else
+	{
+		for (int i = 0; i < 12; i++)
+		{
+			calib[2 * i] = (uint8_t)(datasheet_trim[i] & 0xFF);
+			calib[2 * i + 1] = (uint8_t)((datasheet_trim[i] >> 8) & 0xFF);
+		}
+	}
+	BMP280_CompInit(&c, calib);
+
+	for (int32_t adc_T = 0; adc_T <= ADC_MAX; adc_T += step)
+	{
+		int32_t t_fine;
+		float t_fine_f;
+		int32_t t_ref = BMP280_CompTemperatureInt32(&c, adc_T, &t_fine);
+		if (t_ref < T_MIN_X100 || t_ref > T_MAX_X100) continue;
+
+		float t_f = BMP280_CompTemperatureFloat(&c, adc_T, &t_fine_f);
+		Track(&temp_float, t_f - t_ref / 100.0, adc_T, 0);
+
+		for (int32_t adc_P = 0; adc_P <= ADC_MAX; adc_P += step)
+		{
+			uint32_t p_ref_q8 = BMP280_CompPressureInt64(&c, adc_P, t_fine);
+			double p_ref = p_ref_q8 / 256.0;
+			if (p_ref < P_MIN_PA || p_ref > P_MAX_PA)
+			{
+				skipped++;
+				continue;
+			}
+
+			Track(&press_int32, (double)BMP280_CompPressureInt32(&c, adc_P, t_fine) - p_ref, adc_T, adc_P);
+			Track(&press_float, (double)BMP280_CompPressureFloat(&c, adc_P, t_fine_f) - p_ref, adc_T, adc_P);
+		}
+	}
+
+	printf("BMP280 compensation vs 64-bit reference (step %d, %llu points in range, %llu outside)\n",
+	       step, (unsigned long long)press_float.count, (unsigned long long)skipped);
+	Report("pressure float", "Pa", &press_float);
+	Report("pressure int32", "Pa", &press_int32);
+	Report("temperature float", "C ", &temp_float);
+
+	HostTiming(&c);
+	return 0;
+}
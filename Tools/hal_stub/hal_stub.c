@@ -0,0 +1,78 @@
+/*
+ * hal_stub.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ *
+ * Registros en RAM y funciones triviales de la HAL sustituta (ver stm32f4xx_hal.h).
+ * Las transferencias (HAL_I2C_*_DMA, etc.) las define cada banco de prueba.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "stm32f4xx_hal.h"
+
+SPI_TypeDef stub_spi2;
+I2C_TypeDef stub_i2c1, stub_i2c3;
+DMA_Stream_TypeDef stub_dma1_stream[8];
+GPIO_TypeDef stub_gpioa, stub_gpiob, stub_gpioc;
+uint32_t stub_primask;
+
+static uint32_t stub_tick;
+
+void Error_Handler(void)
+{
+	fprintf(stderr, "Error_Handler()\n");
+	exit(2);
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type irq, uint32_t preempt, uint32_t sub)
+{
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type irq)
+{
+}
+
+void HAL_Delay(uint32_t ms)
+{
+	stub_tick += ms;
+}
+
+uint32_t HAL_GetTick(void)
+{
+	return stub_tick;
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+	return 42000000U;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *port, GPIO_InitTypeDef *init)
+{
+}
+
+void HAL_GPIO_DeInit(GPIO_TypeDef *port, uint32_t pin)
+{
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state)
+{
+	if (state == GPIO_PIN_SET) port->ODR |= pin;
+	else port->ODR &= ~(uint32_t)pin;
+}
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma)
+{
+	return HAL_OK;
+}
+
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma)
+{
+}
+
+/* Logging tokenizado (API_log.h): se descarta en el host */
+void logEmit(uint16_t id, const uint32_t *args, uint8_t count)
+{
+}
@@ -0,0 +1,229 @@
+/*
+ * stm32f4xx_hal.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ *
+ * Sustituto mínimo de la HAL para compilar los módulos de Drivers/API en el host (Linux, gcc).
+ * Solo declara los tipos, constantes y funciones que usan esos módulos; los registros son
+ * estructuras en RAM (hal_stub.c) y las transferencias las simula cada banco de prueba.
+ *
+ * Uso: anteponer -I../hal_stub a -I../../Drivers/API/Inc y enlazar ../hal_stub/hal_stub.c.
+ */
+
+#ifndef TOOLS_HAL_STUB_STM32F4XX_HAL_H_
+#define TOOLS_HAL_STUB_STM32F4XX_HAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum
+{
+	HAL_OK = 0,
+	HAL_ERROR,
+	HAL_BUSY,
+	HAL_TIMEOUT
+} HAL_StatusTypeDef;
+
+#define HAL_MAX_DELAY  0xFFFFFFFFU
+
+typedef enum
+{
+	DMA1_Stream2_IRQn = 13,
+	DMA1_Stream3_IRQn,
+	DMA1_Stream4_IRQn,
+	DMA1_Stream5_IRQn,
+	DMA1_Stream6_IRQn,
+	EXTI9_5_IRQn = 23,
+	I2C1_EV_IRQn = 31,
+	I2C1_ER_IRQn,
+	SPI2_IRQn = 36,
+	DMA1_Stream7_IRQn = 47,
+	I2C3_EV_IRQn = 72,
+	I2C3_ER_IRQn
+} IRQn_Type;
+
+/* Registros */
+typedef struct { volatile uint32_t CR1, CR2, SR, DR; } SPI_TypeDef;
+typedef struct { volatile uint32_t CR1, CR2; } I2C_TypeDef;
+typedef struct { volatile uint32_t CR; } DMA_Stream_TypeDef;
+typedef struct { volatile uint32_t MODER, ODR, BSRR; } GPIO_TypeDef;
+
+extern SPI_TypeDef stub_spi2;
+extern I2C_TypeDef stub_i2c1, stub_i2c3;
+extern DMA_Stream_TypeDef stub_dma1_stream[8];
+extern GPIO_TypeDef stub_gpioa, stub_gpiob, stub_gpioc;
+
+#define SPI2          (&stub_spi2)
+#define I2C1          (&stub_i2c1)
+#define I2C3          (&stub_i2c3)
+#define DMA1_Stream2  (&stub_dma1_stream[2])
+#define DMA1_Stream3  (&stub_dma1_stream[3])
+#define DMA1_Stream4  (&stub_dma1_stream[4])
+#define DMA1_Stream7  (&stub_dma1_stream[7])
+#define GPIOA         (&stub_gpioa)
+#define GPIOB         (&stub_gpiob)
+#define GPIOC         (&stub_gpioc)
+
+#define READ_BIT(REG, BIT)                     ((REG) & (BIT))
+#define MODIFY_REG(REG, CLEARMASK, SETMASK)    ((REG) = (((REG) & (~(CLEARMASK))) | (SETMASK)))
+#define POSITION_VAL(VAL)                      ((uint32_t)__builtin_ctz(VAL))
+
+/* Núcleo: no hay interrupciones reales, PRIMASK solo se registra */
+extern uint32_t stub_primask;
+static inline uint32_t __get_PRIMASK(void) { return stub_primask; }
+static inline void __set_PRIMASK(uint32_t primask) { stub_primask = primask; }
+static inline void __disable_irq(void) { stub_primask = 1; }
+
+void HAL_NVIC_SetPriority(IRQn_Type irq, uint32_t preempt, uint32_t sub);
+void HAL_NVIC_EnableIRQ(IRQn_Type irq);
+void HAL_Delay(uint32_t ms);
+uint32_t HAL_GetTick(void);
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+
+/* GPIO */
+#define GPIO_PIN_4             ((uint16_t)0x0010)
+#define GPIO_PIN_5             ((uint16_t)0x0020)
+#define GPIO_PIN_12            ((uint16_t)0x1000)
+#define GPIO_MODE_OUTPUT_PP    0x01U
+#define GPIO_MODE_IT_RISING    0x10110000U
+#define GPIO_NOPULL            0x00U
+#define GPIO_PULLDOWN          0x02U
+#define GPIO_SPEED_FREQ_LOW    0x00U
+
+typedef enum { GPIO_PIN_RESET = 0, GPIO_PIN_SET } GPIO_PinState;
+
+typedef struct
+{
+	uint32_t Pin, Mode, Pull, Speed, Alternate;
+} GPIO_InitTypeDef;
+
+void HAL_GPIO_Init(GPIO_TypeDef *port, GPIO_InitTypeDef *init);
+void HAL_GPIO_DeInit(GPIO_TypeDef *port, uint32_t pin);
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+#define __HAL_GPIO_EXTI_CLEAR_IT(pin)  ((void)(pin))
+
+/* DMA */
+#define DMA_CHANNEL_0          0x00000000U
+#define DMA_CHANNEL_1          0x02000000U
+#define DMA_CHANNEL_3          0x06000000U
+#define DMA_PERIPH_TO_MEMORY   0x00000000U
+#define DMA_MEMORY_TO_PERIPH   0x00000040U
+#define DMA_PINC_DISABLE       0x00000000U
+#define DMA_MINC_ENABLE        0x00000400U
+#define DMA_PDATAALIGN_BYTE    0x00000000U
+#define DMA_MDATAALIGN_BYTE    0x00000000U
+#define DMA_NORMAL             0x00000000U
+#define DMA_PRIORITY_LOW       0x00000000U
+#define DMA_PRIORITY_MEDIUM    0x00010000U
+#define DMA_PRIORITY_HIGH      0x00020000U
+#define DMA_FIFOMODE_DISABLE   0x00000000U
+#define __HAL_RCC_DMA1_CLK_ENABLE()  ((void)0)
+
+typedef struct
+{
+	uint32_t Channel, Direction, PeriphInc, MemInc, PeriphDataAlignment, MemDataAlignment;
+	uint32_t Mode, Priority, FIFOMode;
+} DMA_InitTypeDef;
+
+typedef struct __DMA_HandleTypeDef
+{
+	DMA_Stream_TypeDef *Instance;
+	DMA_InitTypeDef    Init;
+	void               *Parent;
+} DMA_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma);
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma);
+
+#define __HAL_LINKDMA(__HANDLE__, __PPP_DMA_FIELD__, __DMA_HANDLE__) \
+	do { (__HANDLE__)->__PPP_DMA_FIELD__ = &(__DMA_HANDLE__); (__DMA_HANDLE__).Parent = (__HANDLE__); } while (0)
+
+/* SPI */
+#define SPI_CR1_CPHA_Pos            0U
+#define SPI_CR1_CPHA                (1U << SPI_CR1_CPHA_Pos)
+#define SPI_CR1_CPOL                (1U << 1)
+#define SPI_CR1_BR_Pos              3U
+#define SPI_CR1_BR                  (7U << SPI_CR1_BR_Pos)
+#define SPI_CR1_SPE                 (1U << 6)
+#define SPI_FLAG_BSY                (1U << 7)
+
+#define SPI_MODE_MASTER             0x00000104U
+#define SPI_DIRECTION_2LINES        0x00000000U
+#define SPI_DATASIZE_8BIT           0x00000000U
+#define SPI_POLARITY_LOW            0x00000000U
+#define SPI_PHASE_1EDGE             0x00000000U
+#define SPI_NSS_SOFT                0x00000200U
+#define SPI_BAUDRATEPRESCALER_256   SPI_CR1_BR
+#define SPI_FIRSTBIT_MSB            0x00000000U
+#define SPI_TIMODE_DISABLE          0x00000000U
+#define SPI_CRCCALCULATION_DISABLE  0x00000000U
+
+typedef struct
+{
+	uint32_t Mode, Direction, DataSize, CLKPolarity, CLKPhase, NSS, BaudRatePrescaler;
+	uint32_t FirstBit, TIMode, CRCCalculation, CRCPolynomial;
+} SPI_InitTypeDef;
+
+typedef struct
+{
+	SPI_TypeDef       *Instance;
+	SPI_InitTypeDef   Init;
+	DMA_HandleTypeDef *hdmatx;
+	DMA_HandleTypeDef *hdmarx;
+} SPI_HandleTypeDef;
+
+#define __HAL_SPI_GET_FLAG(__HANDLE__, __FLAG__)  (((__HANDLE__)->Instance->SR & (__FLAG__)) == (__FLAG__))
+#define __HAL_SPI_ENABLE(__HANDLE__)              ((__HANDLE__)->Instance->CR1 |= SPI_CR1_SPE)
+#define __HAL_SPI_DISABLE(__HANDLE__)             ((__HANDLE__)->Instance->CR1 &= ~SPI_CR1_SPE)
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi);
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *data, uint16_t size, uint32_t timeout);
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *data, uint16_t size, uint32_t timeout);
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *data, uint16_t size);
+HAL_StatusTypeDef HAL_SPI_Receive_DMA(SPI_HandleTypeDef *hspi, uint8_t *data, uint16_t size);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *tx, uint8_t *rx, uint16_t size);
+void HAL_SPI_IRQHandler(SPI_HandleTypeDef *hspi);
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi);
+
+/* I2C */
+#define I2C_DUTYCYCLE_2           0x00000000U
+#define I2C_ADDRESSINGMODE_7BIT   0x00004000U
+#define I2C_DUALADDRESS_DISABLE   0x00000000U
+#define I2C_GENERALCALL_DISABLE   0x00000000U
+#define I2C_NOSTRETCH_DISABLE     0x00000000U
+#define I2C_MEMADD_SIZE_8BIT      0x00000001U
+
+typedef struct
+{
+	uint32_t ClockSpeed, DutyCycle, OwnAddress1, AddressingMode, DualAddressMode;
+	uint32_t OwnAddress2, GeneralCallMode, NoStretchMode;
+} I2C_InitTypeDef;
+
+typedef struct
+{
+	I2C_TypeDef       *Instance;
+	I2C_InitTypeDef   Init;
+	DMA_HandleTypeDef *hdmatx;
+	DMA_HandleTypeDef *hdmarx;
+} I2C_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t addr, uint32_t trials, uint32_t timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t addr, uint8_t *data, uint16_t size);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t addr, uint8_t *data, uint16_t size);
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef *hi2c, uint16_t addr, uint16_t mem, uint16_t mem_size, uint8_t *data, uint16_t size);
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef *hi2c, uint16_t addr, uint16_t mem, uint16_t mem_size, uint8_t *data, uint16_t size);
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c, uint16_t addr, uint16_t mem, uint16_t mem_size, uint8_t *data, uint16_t size);
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef *hi2c, uint16_t addr, uint16_t mem, uint16_t mem_size, uint8_t *data, uint16_t size);
+void HAL_I2C_EV_IRQHandler(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ER_IRQHandler(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+
+#endif /* TOOLS_HAL_STUB_STM32F4XX_HAL_H_ */
@@ -0,0 +1,253 @@
+/*
+ * i2c_bus_test.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ *
+ * Banco de prueba en el host de la cola de transacciones de Drivers/API/Src/i2c_bus.c.
+ * Una HAL I2C simulada acepta una transferencia por bus (HAL_BUSY si ya hay una en curso, como
+ * la HAL real) y la completa cuando el banco "atiende la interrupción" con pump().
+ *
+ * Compilar: gcc -O2 -Wall -I../hal_stub -I../../Drivers/API/Inc -o i2c_bus_test \
+ *               i2c_bus_test.c ../hal_stub/hal_stub.c ../../Drivers/API/Src/i2c_bus.c
+ * Uso:      ./i2c_bus_test     (código de salida 0 si todas las pruebas pasan)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "i2c_bus.h"
+
+typedef struct
+{
+	I2C_HandleTypeDef *hi2c;       // NULL: sin transferencia en curso
+	uint8_t           type;        // 0 transmit, 1 mem read, 2 mem write
+	uint16_t          mem;
+	uint8_t           *data;
+	uint16_t          size;
+} FakeXfer;
+
+static FakeXfer inflight;
+static unsigned started;          // transferencias aceptadas por la HAL simulada
+static unsigned rejected_busy;    // intentos de lanzar con el bus ocupado (no debe ocurrir)
+static uint16_t fail_mem = 0xFFFF;  // registro cuyo lanzamiento la HAL rechaza con HAL_ERROR
+static int failures;
+
+static uint8_t order[16];
+static unsigned order_len;
+
+#define CHECK(cond)                                                              \
+	do {                                                                         \
+		if (!(cond)) { printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } \
+	} while (0)
+
+static HAL_StatusTypeDef FakeStart(I2C_HandleTypeDef *hi2c, uint8_t type, uint16_t mem, uint8_t *data, uint16_t size)
+{
+	if (inflight.hi2c != NULL)
+	{
+		rejected_busy++;
+		return HAL_BUSY;
+	}
+	if (mem == fail_mem) return HAL_ERROR;
+
+	inflight = (FakeXfer){ hi2c, type, mem, data, size };
+	started++;
+	return HAL_OK;
+}
+
+/* Fin de la transferencia en curso, como lo haría la interrupción de la DMA */
+static int pump(void)
+{
+	if (inflight.hi2c == NULL) return 0;
+
+	FakeXfer done = inflight;
+	inflight.hi2c = NULL;
+	order[order_len++] = (uint8_t)done.mem;
+
+	switch (done.type)
+	{
+	case 0: HAL_I2C_MasterTxCpltCallback(done.hi2c); break;
+	case 1: memset(done.data, done.mem, done.size); HAL_I2C_MemRxCpltCallback(done.hi2c); break;
+	default: HAL_I2C_MemTxCpltCallback(done.hi2c); break;
+	}
+	return 1;
+}
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c) { return HAL_OK; }
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t addr, uint32_t trials, uint32_t timeout) { return HAL_OK; }
+void HAL_I2C_EV_IRQHandler(I2C_HandleTypeDef *hi2c) {}
+void HAL_I2C_ER_IRQHandler(I2C_HandleTypeDef *hi2c) {}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t addr, uint8_t *data, uint16_t size)
+{
+	return FakeStart(hi2c, 0, data[0], data, size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t addr, uint8_t *data, uint16_t size)
+{
+	return FakeStart(hi2c, 0, data[0], data, size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef *hi2c, uint16_t addr, uint16_t mem, uint16_t mem_size, uint8_t *data, uint16_t size)
+{
+	return FakeStart(hi2c, 1, mem, data, size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef *hi2c, uint16_t addr, uint16_t mem, uint16_t mem_size, uint8_t *data, uint16_t size)
+{
+	return FakeStart(hi2c, 1, mem, data, size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c, uint16_t addr, uint16_t mem, uint16_t mem_size, uint8_t *data, uint16_t size)
+{
+	return FakeStart(hi2c, 2, mem, data, size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef *hi2c, uint16_t addr, uint16_t mem, uint16_t mem_size, uint8_t *data, uint16_t size)
+{
+	return FakeStart(hi2c, 2, mem, data, size);
+}
+
+/* Cadena: cada callback encola la lectura del registro siguiente hasta `last` */
+typedef struct
+{
+	uint8_t           buf[4];
+	uint8_t           next;
+	uint8_t           last;
+	unsigned          calls;
+	HAL_StatusTypeDef status[8];
+} Chain;
+
+static void ChainCallback(HAL_StatusTypeDef status, void *context)
+{
+	Chain *chain = context;
+	chain->status[chain->calls++] = status;
+	if (chain->next > chain->last) return;
+
+	I2C_Transaction xfer = {
+		.type = I2C_XFER_MEM_READ, .dev_addr = 0x68 << 1, .mem_addr = chain->next++,
+		.data = chain->buf, .size = sizeof(chain->buf),
+		.callback = ChainCallback, .context = chain,
+	};
+	CHECK(I2C_Bus_Submit(I2C_BUS_3, &xfer));
+}
+
+static void Reset(void)
+{
+	while (pump()) {
+	}
+	started = rejected_busy = 0;
+	order_len = 0;
+	fail_mem = 0xFFFF;
+}
+
+static void SubmitRead(uint8_t reg, Chain *chain)
+{
+	I2C_Transaction xfer = {
+		.type = I2C_XFER_MEM_READ, .dev_addr = 0x68 << 1, .mem_addr = reg,
+		.data = chain->buf, .size = sizeof(chain->buf),
+		.callback = ChainCallback, .context = chain,
+	};
+	CHECK(I2C_Bus_Submit(I2C_BUS_3, &xfer));
+}
+
+/* Callback que encola la siguiente transacción con la cola vacía (caso del drenado de la FIFO) */
+static void TestChainFromEmptyQueue(void)
+{
+	Chain chain = { .next = 0x11, .last = 0x13 };
+
+	printf("chain from callback, empty queue\n");
+	Reset();
+	SubmitRead(0x10, &chain);
+	CHECK(started == 1);
+
+	while (pump()) {
+	}
+
+	CHECK(started == 4);
+	CHECK(rejected_busy == 0);
+	CHECK(chain.calls == 4);
+	for (unsigned i = 0; i < chain.calls; i++) CHECK(chain.status[i] == HAL_OK);
+	CHECK(order_len == 4 && order[0] == 0x10 && order[3] == 0x13);
+	CHECK(chain.buf[0] == 0x13);
+	CHECK(I2C_Bus_IsIdle(I2C_BUS_3));
+}
+
+/* Con otra transacción ya en cola, la encolada desde el callback va detrás (orden FIFO) */
+static void TestChainBehindPending(void)
+{
+	Chain a = { .next = 0x21, .last = 0x21 };
+	Chain b = { .next = 1, .last = 0 };
+
+	printf("chain from callback, queue not empty\n");
+	Reset();
+	SubmitRead(0x20, &a);
+	SubmitRead(0x30, &b);
+
+	while (pump()) {
+	}
+
+	CHECK(rejected_busy == 0);
+	CHECK(order_len == 3 && order[0] == 0x20 && order[1] == 0x30 && order[2] == 0x21);
+	CHECK(a.calls == 2 && b.calls == 1);
+	CHECK(I2C_Bus_IsIdle(I2C_BUS_3));
+}
+
+/* Lanzamiento rechazado por la HAL: el error se informa y la cadena sigue */
+static void TestChainAfterRejectedStart(void)
+{
+	Chain a = { .next = 0x41, .last = 0x41 };
+
+	printf("chain from callback after a rejected start\n");
+	Reset();
+	fail_mem = 0x40;
+	SubmitRead(0x40, &a);
+
+	CHECK(a.calls == 1 && a.status[0] == HAL_ERROR);
+	CHECK(started == 1);
+
+	while (pump()) {
+	}
+
+	CHECK(a.calls == 2 && a.status[1] == HAL_OK);
+	CHECK(rejected_busy == 0);
+	CHECK(I2C_Bus_IsIdle(I2C_BUS_3));
+}
+
+/* Tras las cadenas la cola sigue coherente: se puede llenar y vaciar entera */
+static void TestQueueStillConsistent(void)
+{
+	Chain c = { .next = 1, .last = 0 };
+	unsigned queued = 0;
+
+	printf("queue fill/drain after chains\n");
+	Reset();
+	for (unsigned i = 0; i < I2C_BUS_QUEUE_LENGTH + 1; i++)
+	{
+		I2C_Transaction xfer = {
+			.type = I2C_XFER_MEM_READ, .dev_addr = 0x68 << 1, .mem_addr = 0x50 + i,
+			.data = c.buf, .size = 1,
+		};
+		if (I2C_Bus_Submit(I2C_BUS_3, &xfer)) queued++;
+	}
+	CHECK(queued == I2C_BUS_QUEUE_LENGTH);
+
+	while (pump()) {
+	}
+
+	CHECK(order_len == I2C_BUS_QUEUE_LENGTH);
+	CHECK(rejected_busy == 0);
+	CHECK(I2C_Bus_IsIdle(I2C_BUS_3));
+}
+
+int main(void)
+{
+	I2C_Bus_Init(I2C_BUS_3);
+
+	TestChainFromEmptyQueue();
+	TestChainBehindPending();
+	TestChainAfterRejectedStart();
+	TestQueueStillConsistent();
+
+	printf("%s (%d failures)\n", failures ? "FAILED" : "OK", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,331 @@
+/*
+ * mpu6050_fifo_sim.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ *
+ * Verificación en el host del vaciado de la FIFO del MPU6050 de punta a punta:
+ * mpu6050_driver.c -> mpu6050_port.c -> i2c_bus.c -> HAL I2C simulada con el mapa de registros
+ * del sensor (INT_STATUS, FIFO_COUNTH/L, FIFO_R_W, USER_CTRL.FIFO_RESET).
+ *
+ * La HAL simulada completa cada transferencia de dos formas:
+ * - asíncrona: la transferencia queda en curso hasta que el banco "atiende la interrupción" con pump(),
+ *   y un segundo lanzamiento mientras tanto devuelve HAL_BUSY, como la HAL real;
+ * - síncrona: el callback de fin se invoca antes de retornar (usado también por las llamadas bloqueantes).
+ *
+ * Compilar: gcc -O2 -Wall -I../hal_stub -I../../Drivers/API/Inc -o mpu6050_fifo_sim mpu6050_fifo_sim.c \
+ *               ../hal_stub/hal_stub.c ../../Drivers/API/Src/i2c_bus.c \
+ *               ../../Drivers/API/Src/mpu6050_port.c ../../Drivers/API/Src/mpu6050_driver.c
+ * Uso:      ./mpu6050_fifo_sim     (código de salida 0 si todas las pruebas pasan)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "mpu6050_driver.h"
+#include "i2c_bus.h"
+
+typedef struct
+{
+	I2C_HandleTypeDef *hi2c;       // NULL: sin transferencia en curso
+	int               read;
+	uint16_t          mem;
+	uint8_t           *data;
+	uint16_t          size;
+} FakeXfer;
+
+/* Sensor simulado */
+static uint8_t regs[256];
+static uint8_t fifo[MPU6050_FIFO_SIZE];
+static uint16_t fifo_len;
+
+static int sync_mode = 1;
+static FakeXfer inflight;
+static unsigned started;
+static unsigned rejected_busy;
+static int failures;
+
+static mpu6050_dev_t imu;
+
+#define CHECK(cond)                                                              \
+	do {                                                                         \
+		if (!(cond)) { printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } \
+	} while (0)
+
+static void SensorRead(uint16_t reg, uint8_t *data, uint16_t size)
+{
+	for (uint16_t i = 0; i < size; i++)
+	{
+		if (reg == FIFO_R_W)
+		{
+			data[i] = fifo[0];
+			if (fifo_len > 0) memmove(fifo, fifo + 1, --fifo_len);
+		}
+		else if (reg + i == INT_STATUS)
+		{
+			data[i] = regs[INT_STATUS];
+			regs[INT_STATUS] = 0;     // se borra al leerse
+		}
+		else if (reg + i == FIFO_COUNTH) data[i] = fifo_len >> 8;
+		else if (reg + i == FIFO_COUNTH + 1) data[i] = fifo_len & 0xFF;
+		else data[i] = regs[(reg + i) & 0xFF];
+	}
+}
+
+static void SensorWrite(uint16_t reg, const uint8_t *data, uint16_t size)
+{
+	for (uint16_t i = 0; i < size; i++) regs[(reg + i) & 0xFF] = data[i];
+	if (reg == USER_CTRL && (data[0] & USER_CTRL_FIFO_RESET))
+	{
+		fifo_len = 0;
+		regs[USER_CTRL] &= ~USER_CTRL_FIFO_RESET;
+	}
+}
+
+static void Finish(FakeXfer *done)
+{
+	if (done->read)
+	{
+		SensorRead(done->mem, done->data, done->size);
+		HAL_I2C_MemRxCpltCallback(done->hi2c);
+	}
+	else
+	{
+		SensorWrite(done->mem, done->data, done->size);
+		HAL_I2C_MemTxCpltCallback(done->hi2c);
+	}
+}
+
+static HAL_StatusTypeDef FakeStart(I2C_HandleTypeDef *hi2c, int read, uint16_t mem, uint8_t *data, uint16_t size)
+{
+	if (inflight.hi2c != NULL)
+	{
+		rejected_busy++;
+		return HAL_BUSY;
+	}
+
+	FakeXfer xfer = { hi2c, read, mem, data, size };
+	started++;
+	if (sync_mode) Finish(&xfer);
+	else inflight = xfer;
+	return HAL_OK;
+}
+
+static int pump(void)
+{
+	if (inflight.hi2c == NULL) return 0;
+
+	FakeXfer done = inflight;
+	inflight.hi2c = NULL;
+	Finish(&done);
+	return 1;
+}
+
+static void PumpAll(void)
+{
+	while (pump()) {
+	}
+}
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c) { return HAL_OK; }
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t addr, uint32_t trials, uint32_t timeout) { return HAL_OK; }
+void HAL_I2C_EV_IRQHandler(I2C_HandleTypeDef *hi2c) {}
+void HAL_I2C_ER_IRQHandler(I2C_HandleTypeDef *hi2c) {}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t addr, uint8_t *data, uint16_t size) { return HAL_ERROR; }
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t addr, uint8_t *data, uint16_t size) { return HAL_ERROR; }
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef *hi2c, uint16_t addr, uint16_t mem, uint16_t mem_size, uint8_t *data, uint16_t size)
+{
+	return FakeStart(hi2c, 1, mem, data, size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef *hi2c, uint16_t addr, uint16_t mem, uint16_t mem_size, uint8_t *data, uint16_t size)
+{
+	return FakeStart(hi2c, 1, mem, data, size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c, uint16_t addr, uint16_t mem, uint16_t mem_size, uint8_t *data, uint16_t size)
+{
+	return FakeStart(hi2c, 0, mem, data, size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef *hi2c, uint16_t addr, uint16_t mem, uint16_t mem_size, uint8_t *data, uint16_t size)
+{
+	return FakeStart(hi2c, 0, mem, data, size);
+}
+
+uint32_t delayGetMicros(void)
+{
+	return 0;
+}
+
+/* Cuadro de 14 bytes (big-endian, orden de FIFO_EN_ALL): accel xyz, temp, gyro xyz */
+static void PushFrames(uint16_t frames, int16_t base)
+{
+	for (uint16_t f = 0; f < frames; f++)
+	{
+		for (int w = 0; w < 7; w++)
+		{
+			int16_t value = (int16_t)(base + f * 16 + w);
+			fifo[fifo_len++] = (uint8_t)(value >> 8);
+			fifo[fifo_len++] = (uint8_t)value;
+		}
+	}
+}
+
+static int SampleMatches(const MPU6050_RawSample *s, int16_t base, uint16_t frame)
+{
+	int16_t v = (int16_t)(base + frame * 16);
+	return s->accel.x == v && s->accel.y == v + 1 && s->accel.z == v + 2 && s->temp == v + 3 &&
+	       s->gyro.x == v + 4 && s->gyro.y == v + 5 && s->gyro.z == v + 6;
+}
+
+static void Drain(void)
+{
+	CHECK(MPU6050_DevFifoStartDrain(&imu));
+	PumpAll();
+}
+
+static void TestDrain(int sync, uint16_t frames)
+{
+	MPU6050_RawSample batch[8];
+	bool_t overflow = true;
+
+	printf("drain %u frames (%s)\n", frames, sync ? "sync" : "async");
+	sync_mode = sync;
+	started = rejected_busy = 0;
+	fifo_len = 0;
+	PushFrames(frames, -300);
+
+	Drain();
+
+	CHECK(MPU6050_DevFifoGetState(&imu) == MPU6050_ACQ_READY);
+	CHECK(started == 3);                   // INT_STATUS, FIFO_COUNT, FIFO_R_W
+	CHECK(rejected_busy == 0);
+	uint16_t n = MPU6050_DevFifoGetBatch(&imu, batch, 8, &overflow);
+	CHECK(n == frames);
+	CHECK(!overflow);
+	for (uint16_t i = 0; i < n; i++) CHECK(SampleMatches(&batch[i], -300, i));
+	CHECK(fifo_len == 0);
+	CHECK(MPU6050_DevFifoGetState(&imu) == MPU6050_ACQ_IDLE);
+	CHECK(I2C_Bus_IsIdle(I2C_BUS_3));
+}
+
+/* Un cuadro incompleto queda en la FIFO para el próximo vaciado */
+static void TestPartialFrame(void)
+{
+	MPU6050_RawSample batch[4];
+
+	printf("drain leaves a partial frame\n");
+	sync_mode = 0;
+	fifo_len = 0;
+	PushFrames(3, 100);
+	fifo_len -= 8;
+
+	Drain();
+
+	CHECK(MPU6050_DevFifoGetBatch(&imu, batch, 4, NULL) == 2);
+	CHECK(SampleMatches(&batch[1], 100, 1));
+	CHECK(fifo_len == 6);
+	CHECK(I2C_Bus_IsIdle(I2C_BUS_3));
+}
+
+static void TestEmpty(void)
+{
+	printf("drain empty FIFO\n");
+	sync_mode = 0;
+	fifo_len = 0;
+	started = 0;
+
+	Drain();
+
+	CHECK(started == 2);
+	CHECK(MPU6050_DevFifoGetState(&imu) == MPU6050_ACQ_READY);
+	CHECK(MPU6050_DevFifoGetBatch(&imu, NULL, 0, NULL) == 0);
+	CHECK(I2C_Bus_IsIdle(I2C_BUS_3));
+}
+
+/* Desborde: se informa, se reinicia la FIFO y no se entregan cuadros desalineados */
+static void TestOverflow(void)
+{
+	bool_t overflow = false;
+	uint32_t before = MPU6050_DevFifoGetOverflowCount(&imu);
+
+	printf("drain after overflow\n");
+	sync_mode = 0;
+	fifo_len = MPU6050_FIFO_SIZE;
+	regs[INT_STATUS] = INT_FIFO_OFLOW;
+
+	Drain();
+
+	CHECK(MPU6050_DevFifoGetState(&imu) == MPU6050_ACQ_READY);
+	CHECK(MPU6050_DevFifoGetBatch(&imu, NULL, 0, &overflow) == 0);
+	CHECK(overflow);
+	CHECK(fifo_len == 0);
+	CHECK(regs[USER_CTRL] == USER_CTRL_FIFO_EN);
+	CHECK(MPU6050_DevFifoGetOverflowCount(&imu) == before + 1);
+	CHECK(I2C_Bus_IsIdle(I2C_BUS_3));
+}
+
+/* FIFO casi llena: se leen todos los cuadros y GetBatch entrega los `max` más recientes */
+static void TestFullBatch(void)
+{
+	MPU6050_RawSample batch[10];
+
+	printf("drain %u frames, keep latest 10\n", MPU6050_FIFO_MAX_FRAMES);
+	sync_mode = 0;
+	fifo_len = 0;
+	PushFrames(MPU6050_FIFO_MAX_FRAMES, 0);
+
+	Drain();
+
+	CHECK(MPU6050_DevFifoGetBatch(&imu, batch, 10, NULL) == 10);
+	CHECK(SampleMatches(&batch[0], 0, MPU6050_FIFO_MAX_FRAMES - 10));
+	CHECK(SampleMatches(&batch[9], 0, MPU6050_FIFO_MAX_FRAMES - 1));
+	CHECK(fifo_len == 0);
+}
+
+/* Una ráfaga de otro cliente del bus encolada en medio del vaciado no rompe la cola */
+static void TestSharedBus(void)
+{
+	MPU6050_RawSample batch[4], sample;
+
+	printf("drain interleaved with a burst acquisition\n");
+	sync_mode = 0;
+	rejected_busy = 0;
+	fifo_len = 0;
+	PushFrames(4, 7);
+	for (int i = 0; i < 14; i++) regs[0x3B + i] = (uint8_t)i;
+
+	CHECK(MPU6050_DevFifoStartDrain(&imu));
+	CHECK(MPU6050_DevStartAcquisition(&imu));
+	PumpAll();
+
+	CHECK(rejected_busy == 0);
+	CHECK(MPU6050_DevFifoGetBatch(&imu, batch, 4, NULL) == 4);
+	CHECK(SampleMatches(&batch[3], 7, 3));
+	CHECK(MPU6050_DevGetAcquisitionResult(&imu, &sample));
+	CHECK(sample.accel.x == 0x0001 && sample.gyro.z == 0x0C0D);
+	CHECK(I2C_Bus_IsIdle(I2C_BUS_3));
+}
+
+int main(void)
+{
+	regs[WHO_AM_I] = MPU6050_WHO_AM_I_VALUE;
+
+	sync_mode = 1;
+	CHECK(MPU6050_DevInit(&imu, I2C_BUS_3, MPU6050_ADDRESS_AD0_LOW));
+	MPU6050_DevFifoEnable(&imu);
+	CHECK(regs[USER_CTRL] == USER_CTRL_FIFO_EN && regs[FIFO_EN] == FIFO_EN_ALL);
+
+	TestDrain(0, 5);
+	TestDrain(1, 3);
+	TestPartialFrame();
+	TestEmpty();
+	TestOverflow();
+	TestFullBatch();
+	TestSharedBus();
+
+	printf("%s (%d failures)\n", failures ? "FAILED" : "OK", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,261 @@
+/*
+ * scheduler_sim.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ *
+ * Verificación en el host del planificador cooperativo (Drivers/API/Src/API_scheduler.c) con un reloj
+ * simulado en µs inyectado como schedulerClock_t. Cada tarea simulada registra sus instantes de inicio
+ * y "trabaja" avanzando el reloj lo que se le indique; cuando no hay tarea liberada el banco avanza el
+ * reloj de a 1 µs, como el lazo principal en vacío.
+ *
+ * Compilar: gcc -O2 -Wall -I../../Drivers/API/Inc -o scheduler_sim scheduler_sim.c \
+ *               ../../Drivers/API/Src/API_scheduler.c
+ * Uso:      ./scheduler_sim     (código de salida 0 si todas las pruebas pasan)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "API_scheduler.h"
+
+#define MAX_STARTS  64
+
+typedef struct
+{
+	uint32_t exec_us;            // duración de cada ejecución
+	uint32_t once_exec_us;       // duración de la próxima ejecución (0: exec_us)
+	uint32_t starts[MAX_STARTS];
+	unsigned count;
+	int8_t   id;
+	uint32_t new_period_us;      // período que la propia tarea fija en su ejecución new_period_run
+	unsigned new_period_run;
+} SimTask;
+
+static uint32_t now_us;
+static const SimTask *order[MAX_STARTS];
+static unsigned order_len;
+static int failures;
+
+#define CHECK(cond)                                                              \
+	do {                                                                         \
+		if (!(cond)) { printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } \
+	} while (0)
+
+static uint32_t SimClock(void)
+{
+	return now_us;
+}
+
+static void SimTaskFn(void *context)
+{
+	SimTask *task = context;
+
+	if (task->count < MAX_STARTS) task->starts[task->count] = now_us;
+	task->count++;
+	if (task->new_period_us != 0 && task->count == task->new_period_run) schedulerSetPeriod(task->id, task->new_period_us);
+	if (order_len < MAX_STARTS) order[order_len++] = task;
+	now_us += task->once_exec_us ? task->once_exec_us : task->exec_us;
+	task->once_exec_us = 0;
+}
+
+/* Lazo principal simulado hasta el instante `end` (comparación tolerante al desborde) */
+static void RunUntil(uint32_t end)
+{
+	while ((int32_t)(now_us - end) < 0)
+	{
+		if (!schedulerRunOnce()) now_us++;
+	}
+}
+
+static void Reset(uint32_t start_us)
+{
+	now_us = start_us;
+	order_len = 0;
+	schedulerInit(SimClock);
+}
+
+static void TestPeriodsAndOffsets(void)
+{
+	SimTask a = { 0 }, b = { 0 };
+
+	printf("per-task periods and offsets\n");
+	Reset(0);
+	int8_t id_a = schedulerAddTask("a", SimTaskFn, &a, 1000, 0);
+	int8_t id_b = schedulerAddTask("b", SimTaskFn, &b, 2500, 300);
+	CHECK(id_a == 0 && id_b == 1);
+	CHECK(schedulerGetTaskCount() == 2);
+	CHECK(strcmp(schedulerGetName(id_b), "b") == 0);
+	RunUntil(10000);
+
+	CHECK(a.count == 10);
+	for (unsigned i = 0; i < a.count && i < MAX_STARTS; i++) CHECK(a.starts[i] == i * 1000);
+	CHECK(b.count == 4);
+	for (unsigned i = 0; i < b.count && i < MAX_STARTS; i++) CHECK(b.starts[i] == 300 + i * 2500);
+
+	schedulerStats_t stats;
+	CHECK(schedulerGetStats(id_a, &stats));
+	CHECK(stats.runs == 10 && stats.overruns == 0 && stats.max_jitter_us == 0);
+	CHECK(!schedulerGetStats(2, &stats));
+	CHECK(schedulerAddTask("bad", SimTaskFn, &a, 0, 0) == -1);
+}
+
+static void TestEarliestDeadlineFirst(void)
+{
+	SimTask slow = { .exec_us = 100 }, fast = { .exec_us = 100 }, tie = { .exec_us = 100 };
+
+	printf("earliest deadline first among tasks released together\n");
+	Reset(0);
+	int8_t id_slow = schedulerAddTask("slow", SimTaskFn, &slow, 5000, 0);
+	int8_t id_fast = schedulerAddTask("fast", SimTaskFn, &fast, 1000, 0);
+	schedulerAddTask("tie", SimTaskFn, &tie, 5000, 0);
+	RunUntil(300);
+
+	// fast vence en 1000, slow y tie en 5000 (empate: orden de registro)
+	CHECK(order_len == 3);
+	CHECK(order[0] == &fast);
+	CHECK(order[1] == &slow);
+	CHECK(order[2] == &tie);
+
+	schedulerStats_t stats;
+	schedulerGetStats(id_fast, &stats);
+	CHECK(stats.last_jitter_us == 0 && stats.last_exec_us == 100);
+	schedulerGetStats(id_slow, &stats);
+	CHECK(stats.last_jitter_us == 100 && stats.max_jitter_us == 100 && stats.last_exec_us == 100);
+	CHECK(tie.starts[0] == 200);
+}
+
+static void TestOverrun(void)
+{
+	SimTask t = { .exec_us = 50 };
+
+	printf("overrun counting and cadence after a long run\n");
+	Reset(0);
+	int8_t id = schedulerAddTask("t", SimTaskFn, &t, 1000, 0);
+	t.once_exec_us = 2500;
+	RunUntil(5000);
+
+	// La primera ejecución termina en 2500: se pierden las liberaciones de 1000 y 2000
+	schedulerStats_t stats;
+	schedulerGetStats(id, &stats);
+	CHECK(stats.overruns == 2);
+	CHECK(stats.max_exec_us == 2500 && stats.last_exec_us == 50);
+	CHECK(t.count == 3);
+	CHECK(t.starts[1] == 3000 && t.starts[2] == 4000);
+
+	// Terminar justo en la próxima liberación también es overrun
+	Reset(0);
+	t = (SimTask){ .exec_us = 50, .once_exec_us = 1000 };
+	id = schedulerAddTask("t", SimTaskFn, &t, 1000, 0);
+	RunUntil(2500);
+	schedulerGetStats(id, &stats);
+	CHECK(stats.overruns == 1);
+	CHECK(t.starts[1] == 2000);
+
+	schedulerResetStats();
+	schedulerGetStats(id, &stats);
+	CHECK(stats.runs == 0 && stats.overruns == 0 && stats.max_exec_us == 0);
+}
+
+static void TestMissedRelease(void)
+{
+	SimTask t = { .exec_us = 10 }, blocker = { .exec_us = 0 };
+
+	printf("jitter and cadence kept after a delayed release\n");
+	Reset(0);
+	int8_t id = schedulerAddTask("t", SimTaskFn, &t, 1000, 0);
+	int8_t id_blocker = schedulerAddTask("blocker", SimTaskFn, &blocker, 10000, 900);
+	blocker.once_exec_us = 700;   // ocupa la CPU de 900 a 1600
+	RunUntil(4000);
+
+	// t se atrasa 600 µs en 1000 pero vuelve a 2000, 3000: no acumula el atraso
+	schedulerStats_t stats;
+	schedulerGetStats(id, &stats);
+	CHECK(t.count == 4);
+	CHECK(t.starts[1] == 1600 && t.starts[2] == 2000 && t.starts[3] == 3000);
+	CHECK(stats.max_jitter_us == 600 && stats.last_jitter_us == 0);
+	CHECK(stats.overruns == 0);
+	schedulerGetStats(id_blocker, &stats);
+	CHECK(stats.max_exec_us == 700);
+}
+
+static void TestSetPeriod(void)
+{
+	SimTask t = { .exec_us = 10 }, self = { .exec_us = 10, .new_period_us = 3000, .new_period_run = 2 };
+
+	printf("period change from outside and from the task itself\n");
+	Reset(0);
+	int8_t id = schedulerAddTask("t", SimTaskFn, &t, 1000, 0);
+	RunUntil(2500);
+	CHECK(t.count == 3);
+
+	// Más corto: la liberación 2000 + 200 ya pasó, se libera ya y sigue la nueva cadencia
+	CHECK(schedulerSetPeriod(id, 200));
+	RunUntil(3000);
+	CHECK(t.count == 6 && t.starts[3] == 2500 && t.starts[4] == 2700 && t.starts[5] == 2900);
+
+	// Más largo: la próxima liberación es la anterior (2900) + 1500
+	CHECK(schedulerSetPeriod(id, 1500));
+	RunUntil(6000);
+	CHECK(t.count == 8 && t.starts[6] == 4400 && t.starts[7] == 5900);
+
+	schedulerStats_t stats;
+	schedulerGetStats(id, &stats);
+	CHECK(stats.overruns == 0 && stats.max_jitter_us == 0);
+	CHECK(!schedulerSetPeriod(id, 0));
+	CHECK(!schedulerSetPeriod(1, 1000));
+
+	// Desde la propia tarea, en su segunda ejecución (1000): la siguiente es 1000 + 3000
+	Reset(0);
+	self.id = schedulerAddTask("self", SimTaskFn, &self, 1000, 0);
+	RunUntil(8000);
+	CHECK(self.count == 4);
+	CHECK(self.starts[1] == 1000 && self.starts[2] == 4000 && self.starts[3] == 7000);
+	schedulerGetStats(self.id, &stats);
+	CHECK(stats.overruns == 0);
+}
+
+static void TestWrap(void)
+{
+	const uint32_t start = 0xFFFFFFFFu - 2500;
+	SimTask a = { .exec_us = 20 }, b = { .exec_us = 20 }, late = { 0 };
+
+	printf("clock wrap at 0xFFFFFFFF\n");
+	Reset(start);
+	int8_t id_a = schedulerAddTask("a", SimTaskFn, &a, 1000, 0);
+	schedulerAddTask("b", SimTaskFn, &b, 3000, 200);
+	schedulerAddTask("late", SimTaskFn, &late, 1000, 6000);   // primera liberación después del desborde
+	RunUntil(start + 10000);
+
+	CHECK(a.count == 10);
+	for (unsigned i = 1; i < a.count && i < MAX_STARTS; i++) CHECK(a.starts[i] - a.starts[i - 1] == 1000);
+	CHECK(b.count == 4);
+	for (unsigned i = 0; i < b.count && i < MAX_STARTS; i++) CHECK(b.starts[i] == start + 200 + i * 3000);
+	// Liberada junto con a (mismo vencimiento, registrada después): arranca al terminar a
+	CHECK(late.count == 4 && late.starts[0] == start + 6020 && late.starts[3] == start + 9020);
+
+	schedulerStats_t stats;
+	schedulerGetStats(id_a, &stats);
+	CHECK(stats.overruns == 0 && stats.max_jitter_us <= 20 && stats.max_exec_us == 20);
+
+	// Liberadas juntas a ambos lados del desborde: vence primero la de período corto
+	Reset(0xFFFFFFFFu - 100);
+	a = (SimTask){ .exec_us = 10 };
+	b = (SimTask){ .exec_us = 10 };
+	schedulerAddTask("a", SimTaskFn, &a, 5000, 0);
+	schedulerAddTask("b", SimTaskFn, &b, 50, 0);
+	RunUntil(0xFFFFFFFFu - 70);
+	CHECK(order_len >= 2 && order[0] == &b && order[1] == &a);
+}
+
+int main(void)
+{
+	TestPeriodsAndOffsets();
+	TestEarliestDeadlineFirst();
+	TestOverrun();
+	TestMissedRelease();
+	TestSetPeriod();
+	TestWrap();
+
+	printf("%s (%d failures)\n", failures ? "FAILED" : "OK", failures);
+	return failures ? 1 : 0;
+}
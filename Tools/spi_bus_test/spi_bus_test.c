@@ -0,0 +1,202 @@
+/*
+ * spi_bus_test.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ *
+ * Banco de prueba en el host del gestor de SPI2 (Drivers/API/Src/spi_bus.c).
+ * Una HAL SPI simulada acepta una transferencia DMA a la vez (HAL_BUSY si ya hay una en curso,
+ * como la HAL real) y la completa cuando el banco "atiende la interrupción" con pump().
+ *
+ * Compilar: gcc -O2 -Wall -I../hal_stub -I../../Drivers/API/Inc -o spi_bus_test \
+ *               spi_bus_test.c ../hal_stub/hal_stub.c ../../Drivers/API/Src/spi_bus.c
+ * Uso:      ./spi_bus_test     (código de salida 0 si todas las pruebas pasan)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "spi_bus.h"
+
+#define BUS_CONFIG(cr1)  ((cr1) & (SPI_CR1_BR | SPI_CR1_CPOL | SPI_CR1_CPHA))
+
+typedef struct
+{
+	int      busy;
+	uint8_t  *rx;
+	uint16_t size;
+	uint8_t  tag;        // primer byte transmitido
+} FakeXfer;
+
+static FakeXfer inflight;
+static unsigned started;
+static unsigned rejected_busy;
+static uint32_t cr1_at_start[16];
+static uint8_t order[16];
+static unsigned order_len;
+static int failures;
+
+static SPI_BusDevice baro_a, baro_b, flash;
+
+#define CHECK(cond)                                                              \
+	do {                                                                         \
+		if (!(cond)) { printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); failures++; } \
+	} while (0)
+
+static HAL_StatusTypeDef FakeStart(SPI_HandleTypeDef *hspi, const uint8_t *tx, uint8_t *rx, uint16_t size)
+{
+	if (inflight.busy)
+	{
+		rejected_busy++;
+		return HAL_BUSY;
+	}
+	inflight = (FakeXfer){ 1, rx, size, tx != NULL ? tx[0] : 0 };
+	cr1_at_start[started % 16] = hspi->Instance->CR1;
+	started++;
+	return HAL_OK;
+}
+
+static int pump(void)
+{
+	if (!inflight.busy) return 0;
+
+	FakeXfer done = inflight;
+	inflight.busy = 0;
+	order[order_len++] = done.tag;
+	if (done.rx != NULL) memset(done.rx, done.tag, done.size);
+	HAL_SPI_TxRxCpltCallback(SPI_Bus_GetHandle());
+	return 1;
+}
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi)
+{
+	hspi->Instance->CR1 = hspi->Init.BaudRatePrescaler | hspi->Init.CLKPolarity | hspi->Init.CLKPhase;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *data, uint16_t size, uint32_t timeout) { return HAL_OK; }
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *data, uint16_t size, uint32_t timeout) { return HAL_OK; }
+void HAL_SPI_IRQHandler(SPI_HandleTypeDef *hspi) {}
+
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *data, uint16_t size)
+{
+	return FakeStart(hspi, data, NULL, size);
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive_DMA(SPI_HandleTypeDef *hspi, uint8_t *data, uint16_t size)
+{
+	return FakeStart(hspi, NULL, data, size);
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *tx, uint8_t *rx, uint16_t size)
+{
+	return FakeStart(hspi, tx, rx, size);
+}
+
+/* Cadena al estilo de BMP280_SeqStep: cada callback encola la ráfaga del dispositivo siguiente */
+typedef struct
+{
+	SPI_BusDevice *devs[4];
+	uint8_t       tx[4][7];
+	uint8_t       rx[4][7];
+	uint8_t       count;
+	uint8_t       index;
+	unsigned      ok;
+	int           cs_high_in_callback;
+} Chain;
+
+static void ChainSubmit(Chain *chain);
+
+static void ChainCallback(HAL_StatusTypeDef status, void *context)
+{
+	Chain *chain = context;
+	const SPI_BusDevice *dev = chain->devs[chain->index];
+
+	if (status == HAL_OK) chain->ok++;
+	if (!(dev->cs_port->ODR & dev->cs_pin)) chain->cs_high_in_callback = 0;
+	if (++chain->index < chain->count) ChainSubmit(chain);
+}
+
+static void ChainSubmit(Chain *chain)
+{
+	SPI_Transaction xfer = {
+		chain->devs[chain->index], chain->tx[chain->index], chain->rx[chain->index], 7,
+		ChainCallback, chain,
+	};
+	CHECK(SPI_Bus_Submit(&xfer));
+}
+
+static void Reset(void)
+{
+	while (pump()) {
+	}
+	started = rejected_busy = 0;
+	order_len = 0;
+}
+
+static void TestPrescaler(void)
+{
+	printf("prescaler per device (PCLK1 = 42 MHz)\n");
+	CHECK(baro_a.clock_hz == 5250000 && BUS_CONFIG(baro_a.cr1) == (2U << SPI_CR1_BR_Pos));
+	CHECK(flash.clock_hz == 21000000 && BUS_CONFIG(flash.cr1) == (SPI_CR1_CPOL | SPI_CR1_CPHA));
+
+	SPI_BusDevice slow;
+	CHECK(!SPI_Bus_DeviceInit(&slow, GPIOC, GPIO_PIN_4, 100000, SPI_BUS_MODE_0));
+}
+
+static void TestChainFromCallback(void)
+{
+	Chain chain = { .devs = { &baro_a, &baro_b, &flash }, .count = 3, .cs_high_in_callback = 1 };
+
+	printf("chain from callback (sequencer), empty queue\n");
+	Reset();
+	for (uint8_t i = 0; i < chain.count; i++) chain.tx[i][0] = 0xA0 + i;
+	ChainSubmit(&chain);
+
+	while (pump()) {
+	}
+
+	CHECK(started == 3);
+	CHECK(rejected_busy == 0);
+	CHECK(chain.ok == 3);
+	CHECK(chain.cs_high_in_callback);
+	CHECK(order_len == 3 && order[0] == 0xA0 && order[2] == 0xA2);
+	CHECK(chain.rx[2][6] == 0xA2);
+	CHECK(BUS_CONFIG(cr1_at_start[0]) == baro_a.cr1);
+	CHECK(BUS_CONFIG(cr1_at_start[2]) == flash.cr1);
+	CHECK(cr1_at_start[2] & SPI_CR1_SPE);
+	CHECK(SPI_Bus_IsIdle());
+}
+
+static void TestAcquireDefersQueue(void)
+{
+	uint8_t tx[2] = { 0xB0, 0 }, rx[2];
+	SPI_Transaction xfer = { &baro_b, tx, rx, sizeof(tx), NULL, NULL };
+
+	printf("queued transfer waits for SPI_Bus_Release\n");
+	Reset();
+	SPI_Bus_Acquire(&flash);
+	CHECK(BUS_CONFIG(SPI2->CR1) == flash.cr1);
+	CHECK(SPI_Bus_Submit(&xfer));
+	CHECK(started == 0);
+	SPI_Bus_Release();
+	CHECK(started == 1);
+	CHECK(!(baro_b.cs_port->ODR & baro_b.cs_pin));
+	pump();
+	CHECK(baro_b.cs_port->ODR & baro_b.cs_pin);
+	CHECK(SPI_Bus_IsIdle());
+}
+
+int main(void)
+{
+	SPI_Bus_Init();
+	SPI_Bus_DeviceInit(&baro_a, GPIOA, GPIO_PIN_4, 10000000, SPI_BUS_MODE_0);
+	SPI_Bus_DeviceInit(&baro_b, GPIOB, GPIO_PIN_12, 10000000, SPI_BUS_MODE_0);
+	SPI_Bus_DeviceInit(&flash, GPIOB, GPIO_PIN_5, 50000000, SPI_BUS_MODE_3);
+
+	TestPrescaler();
+	TestChainFromCallback();
+	TestAcquireDefersQueue();
+
+	printf("%s (%d failures)\n", failures ? "FAILED" : "OK", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,322 @@
+/*
+ * telemetry_decoder.c
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: doddy
+ *
+ * Decodificador de telemetría binaria para Linux (ver Drivers/API/Inc/API_telemetry.h).
+ *
+ * Compilar: gcc -O2 -Wall -o telemetry_decoder telemetry_decoder.c
+ * Uso:      ./telemetry_decoder /dev/ttyACM0 [proyecto.logdict]     (configura 115200 8N1 en modo raw)
+ *           ./telemetry_decoder - [proyecto.logdict] < captura.bin  (lee de stdin)
+ *
+ * proyecto.logdict es el diccionario de mensajes tokenizados (sección .log_fmt del ELF), que se
+ * genera como paso post-build: arm-none-eabi-objcopy --dump-section .log_fmt=proyecto.logdict proyecto.elf
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define HEADER_SIZE       6
+#define CRC_SIZE          4
+#define MAX_FRAME         256
+
+#define TYPE_ENV          0x01
+#define TYPE_IMU          0x02
+#define TYPE_LOG          0x03
+
+#define MAX_SPEC          32
+
+typedef struct
+{
+	unsigned long frames;
+	unsigned long crc_errors;
+	unsigned long cobs_errors;
+	unsigned long lost;
+	int           last_seq;
+} decoder_stats_t;
+
+static char  *log_dict = NULL;
+static size_t log_dict_size = 0;
+
+static uint16_t getU16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static uint32_t getU32(const uint8_t *p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+/*
+ * Modelo por software de la unidad CRC del STM32: CRC-32 poly 0x04C11DB7, init 0xFFFFFFFF,
+ * sin reflexión ni XOR final, alimentada con palabras de 32 bits little endian (último tramo
+ * completado con ceros).
+ */
+static uint32_t crc32Stm32(const uint8_t *data, size_t size)
+{
+	uint32_t crc = 0xFFFFFFFFu;
+
+	while (size > 0)
+	{
+		uint8_t word_bytes[4] = {0};
+		size_t chunk = (size < 4) ? size : 4;
+		memcpy(word_bytes, data, chunk);
+		data += chunk;
+		size -= chunk;
+
+		crc ^= getU32(word_bytes);
+		for (int bit = 0; bit < 32; bit++)
+		{
+			crc = (crc & 0x80000000u) ? (crc << 1) ^ 0x04C11DB7u : (crc << 1);
+		}
+	}
+	return crc;
+}
+
+/*
+ * Decodifica COBS. Retorna la longitud decodificada o -1 si el frame es inválido.
+ */
+static int cobsDecode(const uint8_t *src, size_t size, uint8_t *dst)
+{
+	size_t in = 0;
+	size_t out = 0;
+
+	while (in < size)
+	{
+		uint8_t code = src[in++];
+		if (code == 0 || in + code - 1 > size) return -1;
+
+		for (uint8_t i = 1; i < code; i++) dst[out++] = src[in++];
+		if (code != 0xFF && in < size) dst[out++] = 0x00;
+	}
+	return (int)out;
+}
+
+static int loadDictionary(const char *path)
+{
+	FILE *f = fopen(path, "rb");
+	if (f == NULL) return -1;
+
+	fseek(f, 0, SEEK_END);
+	long size = ftell(f);
+	fseek(f, 0, SEEK_SET);
+
+	log_dict = malloc(size + 1);
+	if (log_dict == NULL || fread(log_dict, 1, size, f) != (size_t)size)
+	{
+		fclose(f);
+		return -1;
+	}
+	log_dict[size] = '\0';
+	log_dict_size = size;
+	fclose(f);
+	return 0;
+}
+
+/*
+ * Expande el formato del mensaje con los argumentos crudos de 32 bits, como lo haría printf
+ * en el micro: %d/%i con signo, %u/%x/%X/%o/%c sin signo, %f/%e/%g con los bits de un float.
+ */
+static void printLog(const uint8_t *payload, int size)
+{
+	uint16_t id = getU16(payload);
+	const uint8_t *args = payload + 2;
+	int count = (size - 2) / 4;
+	int next = 0;
+
+	if (id >= log_dict_size)
+	{
+		printf("LOG id=%u (sin diccionario)", id);
+		for (int i = 0; i < count; i++) printf(" 0x%08X", getU32(&args[4 * i]));
+		printf("\n");
+		return;
+	}
+
+	printf("LOG ");
+	for (const char *fmt = &log_dict[id]; *fmt != '\0'; fmt++)
+	{
+		if (*fmt != '%')
+		{
+			putchar(*fmt);
+			continue;
+		}
+		if (fmt[1] == '%')
+		{
+			putchar('%');
+			fmt++;
+			continue;
+		}
+
+		// Copia flags, ancho y precisión; descarta modificadores de longitud
+		char spec[MAX_SPEC];
+		int len = 0;
+		spec[len++] = *fmt++;
+		while (*fmt != '\0' && strchr("-+ #0123456789.", *fmt) != NULL && len < MAX_SPEC - 3) spec[len++] = *fmt++;
+		while (*fmt != '\0' && strchr("hlzjt", *fmt) != NULL) fmt++;
+		if (*fmt == '\0') break;
+
+		char conv = *fmt;
+		uint32_t raw = (next < count) ? getU32(&args[4 * next]) : 0;
+		next++;
+
+		spec[len++] = conv;
+		spec[len] = '\0';
+		switch (conv)
+		{
+		case 'd': case 'i':
+			printf(spec, (int32_t)raw);
+			break;
+		case 'u': case 'x': case 'X': case 'o': case 'c':
+			printf(spec, raw);
+			break;
+		case 'f': case 'e': case 'g': case 'E': case 'G':
+		{
+			float value;
+			memcpy(&value, &raw, sizeof(value));
+			printf(spec, (double)value);
+			break;
+		}
+		default:
+			printf("<%%%c?>", conv);
+			break;
+		}
+	}
+	printf("\n");
+}
+
+static void printFrame(const uint8_t *frame, int size, decoder_stats_t *stats)
+{
+	uint8_t type = frame[0];
+	uint8_t seq = frame[1];
+	uint32_t timestamp = getU32(&frame[2]);
+	const uint8_t *payload = &frame[HEADER_SIZE];
+	int payload_size = size - HEADER_SIZE - CRC_SIZE;
+
+	if (stats->last_seq >= 0) stats->lost += (uint8_t)(seq - stats->last_seq - 1);
+	stats->last_seq = seq;
+	stats->frames++;
+
+	printf("[%10.3f s] #%3u ", timestamp / 1000.0, seq);
+
+	if (type == TYPE_ENV && payload_size == 10)
+	{
+		printf("ENV T=%.2f C  P=%.2f hPa  ALT=%.2f m\n",
+		       (int16_t)getU16(&payload[0]) / 100.0,
+		       getU32(&payload[2]) / 100.0,
+		       (int32_t)getU32(&payload[6]) / 100.0);
+	}
+	else if (type == TYPE_IMU && payload_size == 20)
+	{
+		printf("IMU T=%.2f C  G=(%.2f, %.2f, %.2f) deg/s  A=(%.2f, %.2f, %.2f) g\n",
+		       (int16_t)getU16(&payload[0]) / 100.0,
+		       (int32_t)getU32(&payload[2]) / 100.0, (int32_t)getU32(&payload[6]) / 100.0, (int32_t)getU32(&payload[10]) / 100.0,
+		       (int16_t)getU16(&payload[14]) / 100.0, (int16_t)getU16(&payload[16]) / 100.0, (int16_t)getU16(&payload[18]) / 100.0);
+	}
+	else if (type == TYPE_LOG && payload_size >= 2)
+	{
+		printLog(payload, payload_size);
+	}
+	else
+	{
+		printf("tipo 0x%02X (%d bytes de payload)\n", type, payload_size);
+	}
+	fflush(stdout);
+}
+
+static void handleFrame(const uint8_t *encoded, size_t size, decoder_stats_t *stats)
+{
+	uint8_t frame[MAX_FRAME];
+	int length = cobsDecode(encoded, size, frame);
+
+	if (length < HEADER_SIZE + CRC_SIZE)
+	{
+		stats->cobs_errors++;
+		return;
+	}
+	if (crc32Stm32(frame, length - CRC_SIZE) != getU32(&frame[length - CRC_SIZE]))
+	{
+		stats->crc_errors++;
+		return;
+	}
+	printFrame(frame, length, stats);
+}
+
+static int openSerial(const char *path)
+{
+	int fd = open(path, O_RDONLY | O_NOCTTY);
+	if (fd < 0) return -1;
+
+	struct termios tty;
+	if (tcgetattr(fd, &tty) != 0)
+	{
+		close(fd);
+		return -1;
+	}
+	cfmakeraw(&tty);
+	cfsetispeed(&tty, B115200);
+	cfsetospeed(&tty, B115200);
+	tty.c_cflag |= CLOCAL | CREAD;
+	tty.c_cc[VMIN] = 1;
+	tty.c_cc[VTIME] = 0;
+	if (tcsetattr(fd, TCSANOW, &tty) != 0)
+	{
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc != 2 && argc != 3)
+	{
+		fprintf(stderr, "uso: %s <puerto serie | -> [diccionario .logdict]\n", argv[0]);
+		return 1;
+	}
+	if (argc == 3 && loadDictionary(argv[2]) != 0)
+	{
+		fprintf(stderr, "no se pudo leer el diccionario %s\n", argv[2]);
+		return 1;
+	}
+
+	int fd = (strcmp(argv[1], "-") == 0) ? STDIN_FILENO : openSerial(argv[1]);
+	if (fd < 0)
+	{
+		fprintf(stderr, "no se pudo abrir %s: %s\n", argv[1], strerror(errno));
+		return 1;
+	}
+
+	decoder_stats_t stats = { .last_seq = -1 };
+	uint8_t encoded[MAX_FRAME];
+	size_t length = 0;
+	int overflow = 0;
+	uint8_t chunk[256];
+	ssize_t n;
+
+	while ((n = read(fd, chunk, sizeof(chunk))) > 0)
+	{
+		for (ssize_t i = 0; i < n; i++)
+		{
+			if (chunk[i] == 0x00)
+			{
+				if (length > 0 && !overflow) handleFrame(encoded, length, &stats);
+				else if (overflow) stats.cobs_errors++;
+				length = 0;
+				overflow = 0;
+			}
+			else if (length < sizeof(encoded))
+			{
+				encoded[length++] = chunk[i];
+			}
+			else
+			{
+				overflow = 1;
+			}
+		}
+	}
+
+	fprintf(stderr, "frames=%lu perdidos=%lu crc=%lu cobs=%lu\n",
+	        stats.frames, stats.lost, stats.crc_errors, stats.cobs_errors);
+	return 0;
+}